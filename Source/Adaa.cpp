@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    Adaa.cpp
+    --------
+    Closed-form antiderivatives of the waveshapes built from tanh, atan,
+    clipping and polynomials (see Adaa.h).
+
+    Each case must match its curve in Waveshapers.cpp exactly.
+
+  ==============================================================================
+*/
+
+#include "Adaa.h"
+
+namespace {
+constexpr double pi = juce::MathConstants<double>::pi;
+constexpr double ln2 = 0.693147180559945309;
+
+// log(cosh(v)) without overflow
+inline double logCosh(double v) {
+  const double a = std::abs(v);
+  return a + std::log1p(std::exp(-2.0 * a)) - ln2;
+}
+
+// Antiderivative of tanh(k x)
+inline double tanhIntegral(double x, double k) { return logCosh(k * x) / k; }
+
+// Antiderivative of atan(k x)
+inline double atanIntegral(double x, double k) {
+  return x * std::atan(k * x) - std::log1p(k * k * x * x) / (2.0 * k);
+}
+} // namespace
+
+namespace Adaa {
+
+bool hasClosedForm(int waveshapeIndex) {
+  switch (waveshapeIndex) {
+  case 0:  // Tube
+  case 1:  // Soft Clip
+  case 2:  // Hard Clip
+  case 3:  // Diode 1
+  case 4:  // Diode 2
+  case 8:  // Downsample
+  case 9:  // Asym
+  case 10: // Rectify
+  case 14: // Stomp Box
+  case 16: // Overdrive
+  case 17: // Soft Sat
+    return true;
+  default:
+    return false;
+  }
+}
+
+void processClosedForm(int waveshapeIndex, float *data, int numSamples,
+                       float drive, float shapeParam, ChannelState &state) {
+  const double s = shapeParam;
+  auto run = [&](auto &&F, auto &&f) {
+    process(data, numSamples, drive, state, F, f);
+  };
+
+  switch (waveshapeIndex) {
+  case 0: { // Tube: tanh and x - x^3/3 blended by shape
+    const double k = 1.0 - s * 0.5;
+    run(
+        [=](double x) {
+          const double x2 = x * x;
+          return (1.0 - s) * tanhIntegral(x, k) +
+                 s * (x2 * 0.5 - x2 * x2 / 12.0);
+        },
+        [=](double x) {
+          return std::tanh(x * k) * (1.0 - s) + (x - x * x * x / 3.0) * s;
+        });
+    break;
+  }
+  case 1: // Soft Clip
+  case 8: { // Downsample
+    const double k = waveshapeIndex == 1 ? 1.0 + s * 2.0 : 1.0 + s;
+    run([=](double x) { return tanhIntegral(x, k); },
+        [=](double x) { return std::tanh(x * k); });
+    break;
+  }
+  case 2: { // Hard Clip
+    const double k = 1.0 + s * 3.0;
+    run(
+        [=](double x) {
+          const double v = std::abs(k * x);
+          return (v <= 1.0 ? v * v * 0.5 : v - 0.5) / k;
+        },
+        [=](double x) { return juce::jlimit(-1.0, 1.0, k * x); });
+    break;
+  }
+  case 3: { // Diode 1
+    const double k = 1.0 + s;
+    run([=](double x) { return x > 0.0 ? tanhIntegral(x, k) : x * x * 0.25; },
+        [=](double x) { return x > 0.0 ? std::tanh(x * k) : x * 0.5; });
+    break;
+  }
+  case 4: { // Diode 2
+    const double k = 1.0 + s * 2.0;
+    run([=](double x) { return x > 0.0 ? x * x * 0.35 : tanhIntegral(x, k); },
+        [=](double x) { return x > 0.0 ? x * 0.7 : std::tanh(x * k); });
+    break;
+  }
+  case 9: { // Asym
+    const double k = 1.0 + s * 2.0;
+    run([=](double x) { return x > 0.0 ? tanhIntegral(x, k) : x * x * 0.15; },
+        [=](double x) { return x > 0.0 ? std::tanh(x * k) : x * 0.3; });
+    break;
+  }
+  case 10: { // Rectify
+    const double c = 1.0 - s * 0.5;
+    run([=](double x) { return 0.5 * c * x * std::abs(x); },
+        [=](double x) { return std::abs(x) * c; });
+    break;
+  }
+  case 14: // Stomp Box
+  case 16: { // Overdrive
+    const double k = waveshapeIndex == 14 ? 1.0 + s * 5.0 : 1.0 + s * 10.0;
+    const double gain = waveshapeIndex == 14 ? 1.0 / pi : 2.0 / pi;
+    run([=](double x) { return gain * atanIntegral(x, k); },
+        [=](double x) { return gain * std::atan(x * k); });
+    break;
+  }
+  case 17: { // Soft Sat: x / (1 + s|x|)
+    run(
+        [=](double x) {
+          const double a = std::abs(x);
+          // Series near s = 0, where the exact form cancels
+          if (s < 1.0e-3)
+            return a * a * (0.5 - s * a / 3.0 + s * s * a * a * 0.25);
+          return a / s - std::log1p(s * a) / (s * s);
+        },
+        [=](double x) { return x / (1.0 + std::abs(x) * s); });
+    break;
+  }
+  default:
+    jassertfalse; // hasClosedForm() is false for this waveshape
+    break;
+  }
+}
+
+} // namespace Adaa
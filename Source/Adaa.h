@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    Adaa.h
+    ------
+    First-order antiderivative anti-aliasing (ADAA) for the waveshapes.
+
+    Role:
+    Instead of f(x[n]), ADAA outputs the average of the curve between two
+    consecutive inputs:
+
+      y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1])      (F' = f)
+
+    which is f integrated over the straight line joining the samples. The
+    harmonics that would fold back above Nyquist are attenuated much like
+    a lowpass before the curve, so a lower oversampling factor can be used
+    for the same aliasing: at 2x, ADAA brings the harder curves (clipping,
+    atan) close to the plain curve at 4x, and the softer ones about
+    halfway there in dB (see "steverator_bench --adaa"). The price is a
+    half-sample delay at the oversampled rate and a mild high-frequency
+    roll-off.
+
+    When two inputs are (almost) equal the quotient is ill-conditioned, so
+    the curve is evaluated at the midpoint instead. F is computed in double
+    precision: the quotient subtracts two close values of F.
+
+    The simple curves have a closed-form F here. Every other waveshape gets
+    a tabulated F from WaveshaperTable (see processChannelAdaa()).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+
+namespace Adaa {
+
+// Per-channel memory: the previous driven input
+struct ChannelState {
+  double previous = 0.0;
+};
+
+// Below this input step the midpoint of the curve is used
+constexpr double minDelta = 1.0e-5;
+
+// Runs first-order ADAA over a channel, in place. F is the antiderivative
+// and f the curve, both taking a driven input as double.
+template <typename Antiderivative, typename Curve>
+void process(float *data, int numSamples, float drive, ChannelState &state,
+             Antiderivative &&F, Curve &&f) {
+  double x0 = state.previous;
+  double F0 = F(x0);
+
+  for (int i = 0; i < numSamples; ++i) {
+    const double x1 = (double)data[i] * drive;
+    const double F1 = F(x1);
+    const double delta = x1 - x0;
+    data[i] = (float)(std::abs(delta) > minDelta ? (F1 - F0) / delta
+                                                 : f(0.5 * (x0 + x1)));
+    x0 = x1;
+    F0 = F1;
+  }
+
+  state.previous = x0;
+}
+
+// True if the waveshape has a closed-form antiderivative below
+bool hasClosedForm(int waveshapeIndex);
+
+// ADAA with the closed-form antiderivative of a waveshape
+// (hasClosedForm() must be true)
+void processClosedForm(int waveshapeIndex, float *data, int numSamples,
+                       float drive, float shape, ChannelState &state);
+
+} // namespace Adaa
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    BlockRamp.h
+    -----------
+    Block-rate smoothing for the gain parameters.
+
+    Role:
+    Drive, Mix, Input Gain, Output Gain, Delta Gain and the band levels
+    used to jump to their new value at the start of a block (audible as
+    zipper noise under automation). A BlockRamp glides to its target
+    over rampSeconds instead, one block at a time: advance() moves the
+    value by one block and, only while it is moving, writes the per-sample
+    values of that block into a ramp buffer (a linear fill the compiler
+    vectorizes). The processor then applies the ramp with
+    juce::FloatVectorOperations::multiply(), or the constant gain when the
+    value is not moving, so nothing calls getNextValue() per sample.
+
+    The ramp buffer always holds the values of the last block: on the
+    first block after the target is reached it is filled with the target
+    once, so stages that read it per sample can keep doing so for free.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+class BlockRamp {
+public:
+  static constexpr double rampSeconds = 0.02;
+
+  // Message thread: sizes the ramp buffer (maxBlockSize samples)
+  void prepare(double sampleRate, int maxBlockSize) {
+    rampSamples = juce::jmax(1.0f, (float)(rampSeconds * sampleRate));
+    ramp.assign((size_t)juce::jmax(1, maxBlockSize), end);
+  }
+
+  //==============================================================================
+  // Audio thread
+
+  // The value to glide to; the glide always takes rampSeconds
+  void setTarget(float newTarget) {
+    if (newTarget != target) {
+      target = newTarget;
+      step = std::abs(target - end) / rampSamples;
+    }
+  }
+
+  // Jumps to the target (first block after prepareToPlay())
+  void snapToTarget() {
+    start = end = target;
+    juce::FloatVectorOperations::fill(ramp.data(), end, (int)ramp.size());
+  }
+
+  // Moves the value by one block of numSamples, and fills the ramp buffer
+  // if it moved
+  void advance(int numSamples) {
+    jassert(numSamples <= (int)ramp.size());
+    const bool wasMoving = isMoving();
+    start = end;
+    if (end == target) {
+      if (wasMoving) // keep the buffer constant from now on
+        juce::FloatVectorOperations::fill(ramp.data(), end, (int)ramp.size());
+      return;
+    }
+
+    const float distance = step * (float)numSamples;
+    end = std::abs(target - end) <= distance
+              ? target
+              : end + (target > end ? distance : -distance);
+    fill(ramp.data(), numSamples);
+  }
+
+  bool isMoving() const { return start != end; }
+
+  // Value at the end of the last block (the gain, when not moving)
+  float getValue() const { return end; }
+
+  // Per-sample values of the last block
+  const float *getRamp() const { return ramp.data(); }
+
+  // The last block's values at another rate: numDest samples gliding from
+  // the value before the block to the value after it
+  void fill(float *dest, int numDest) const {
+    const float increment = (end - start) / (float)numDest;
+    for (int i = 0; i < numDest; ++i)
+      dest[i] = start + increment * (float)(i + 1);
+  }
+
+  // data *= the last block's gain
+  void apply(float *data, int numSamples) const {
+    if (isMoving())
+      juce::FloatVectorOperations::multiply(data, ramp.data(), numSamples);
+    else if (end != 1.0f)
+      juce::FloatVectorOperations::multiply(data, end, numSamples);
+  }
+
+private:
+  float start = 1.0f, end = 1.0f, target = 1.0f;
+  float step = 0.0f; // per sample
+  float rampSamples = 1.0f;
+  std::vector<float> ramp;
+};
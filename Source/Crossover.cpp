@@ -0,0 +1,523 @@
+/*
+  ==============================================================================
+
+    Crossover.cpp
+    -------------
+    Fused 3-band crossover (see Crossover.h).
+
+    Each section is the TPT state-variable section used by
+    juce::dsp::LinkwitzRileyFilter, with the same coefficients.
+
+  ==============================================================================
+*/
+
+#include "Crossover.h"
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STEVERATOR_CROSSOVER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STEVERATOR_CROSSOVER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr float R2 = 1.41421356237309505f; // sqrt(2)
+
+struct SectionOutput {
+  float low;
+  float band;
+  float high;
+
+  // 2nd-order allpass, as juce::dsp::LinkwitzRileyFilterType::allpass
+  float allpass() const { return low - R2 * band + high; }
+};
+
+// One TPT section, updating its two states
+inline SectionOutput tick(float x, float g, float h, float &s1, float &s2) {
+  const float yH = (x - (R2 + g) * s1 - s2) * h;
+  const float yB = g * yH + s1;
+  s1 = g * yH + yB;
+  const float yL = g * yB + s2;
+  s2 = g * yB + yL;
+  return {yL, yB, yH};
+}
+
+//==============================================================================
+// Four float lanes for the stereo paths. The lanes hold the left and right
+// channel of two sections: {left, right} in the low half, {left, right} in
+// the high half. Only the baseline instruction sets (SSE2 on x86-64, NEON
+// on arm64) are used, so no dispatch is needed.
+
+#if STEVERATOR_CROSSOVER_SSE2
+struct Lanes {
+  using Reg = __m128;
+
+  static Reg set(float a, float b, float c, float d) {
+    return _mm_setr_ps(a, b, c, d);
+  }
+  static Reg pair(float left, float right) { // {left, right, left, right}
+    return _mm_setr_ps(left, right, left, right);
+  }
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg abs(Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+  // {a low half, b low half}
+  static Reg lowHalves(Reg a, Reg b) { return _mm_movelh_ps(a, b); }
+  // {a low half, b high half}
+  static Reg blend(Reg a, Reg b) {
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 2, 1, 0));
+  }
+  // {a high half, a high half}
+  static Reg highHalf(Reg a) { return _mm_movehl_ps(a, a); }
+
+  static float get0(Reg a) { return _mm_cvtss_f32(a); }
+  static float get1(Reg a) {
+    return _mm_cvtss_f32(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)));
+  }
+  static void store(float *p, Reg a) { _mm_storeu_ps(p, a); }
+};
+#elif STEVERATOR_CROSSOVER_NEON
+struct Lanes {
+  using Reg = float32x4_t;
+
+  static Reg set(float a, float b, float c, float d) {
+    const float values[4] = {a, b, c, d};
+    return vld1q_f32(values);
+  }
+  static Reg pair(float left, float right) {
+    const float32x2_t half = vset_lane_f32(right, vdup_n_f32(left), 1);
+    return vcombine_f32(half, half);
+  }
+  // No fused multiply-add, so the stereo paths round like the scalar ones
+  static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+  static Reg sub(Reg a, Reg b) { return vsubq_f32(a, b); }
+  static Reg mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+  static Reg abs(Reg a) { return vabsq_f32(a); }
+
+  static Reg lowHalves(Reg a, Reg b) {
+    return vcombine_f32(vget_low_f32(a), vget_low_f32(b));
+  }
+  static Reg blend(Reg a, Reg b) {
+    return vcombine_f32(vget_low_f32(a), vget_high_f32(b));
+  }
+  static Reg highHalf(Reg a) {
+    return vcombine_f32(vget_high_f32(a), vget_high_f32(a));
+  }
+
+  static float get0(Reg a) { return vgetq_lane_f32(a, 0); }
+  static float get1(Reg a) { return vgetq_lane_f32(a, 1); }
+  static void store(float *p, Reg a) { vst1q_f32(p, a); }
+};
+#else
+struct Lanes {
+  struct Reg {
+    float v[4];
+  };
+
+  static Reg set(float a, float b, float c, float d) { return {{a, b, c, d}}; }
+  static Reg pair(float left, float right) {
+    return {{left, right, left, right}};
+  }
+  template <typename Op> static Reg map(Reg a, Reg b, Op op) {
+    return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]),
+             op(a.v[3], b.v[3])}};
+  }
+  static Reg add(Reg a, Reg b) {
+    return map(a, b, [](float x, float y) { return x + y; });
+  }
+  static Reg sub(Reg a, Reg b) {
+    return map(a, b, [](float x, float y) { return x - y; });
+  }
+  static Reg mul(Reg a, Reg b) {
+    return map(a, b, [](float x, float y) { return x * y; });
+  }
+  static Reg abs(Reg a) {
+    return map(a, a, [](float x, float) { return std::abs(x); });
+  }
+
+  static Reg lowHalves(Reg a, Reg b) { return {{a.v[0], a.v[1], b.v[0], b.v[1]}}; }
+  static Reg blend(Reg a, Reg b) { return {{a.v[0], a.v[1], b.v[2], b.v[3]}}; }
+  static Reg highHalf(Reg a) { return {{a.v[2], a.v[3], a.v[2], a.v[3]}}; }
+
+  static float get0(Reg a) { return a.v[0]; }
+  static float get1(Reg a) { return a.v[1]; }
+  static void store(float *p, Reg a) {
+    for (int i = 0; i < 4; ++i)
+      p[i] = a.v[i];
+  }
+};
+#endif
+
+using Reg = Lanes::Reg;
+
+// Coefficients of one tick over the four lanes
+struct LaneCoefficients {
+  Reg g, h, r2PlusG;
+
+  LaneCoefficients(float gLow, float hLow, float gHigh, float hHigh)
+      : g(Lanes::set(gLow, gLow, gHigh, gHigh)),
+        h(Lanes::set(hLow, hLow, hHigh, hHigh)),
+        r2PlusG(Lanes::set(R2 + gLow, R2 + gLow, R2 + gHigh, R2 + gHigh)) {}
+};
+
+struct LaneOutput {
+  Reg low, band, high;
+
+  Reg allpass() const {
+    return Lanes::add(Lanes::sub(low, Lanes::mul(Lanes::pair(R2, R2), band)),
+                      high);
+  }
+};
+
+// tick() on four lanes, same operations in the same order
+inline LaneOutput tick(Reg x, const LaneCoefficients &c, Reg &s1, Reg &s2) {
+  using L = Lanes;
+  const Reg yH = L::mul(L::sub(L::sub(x, L::mul(c.r2PlusG, s1)), s2), c.h);
+  const Reg yB = L::add(L::mul(c.g, yH), s1);
+  s1 = L::add(L::mul(c.g, yH), yB);
+  const Reg yL = L::add(L::mul(c.g, yB), s2);
+  s2 = L::add(L::mul(c.g, yB), yL);
+  return {yL, yB, yH};
+}
+
+} // namespace
+
+void ThreeBandCrossover::prepare(double newSampleRate) {
+  sampleRate = newSampleRate;
+  lowCutoff = highCutoff = -1.0f; // recompute on the next setCutoffs()
+  fadeStep = (float)(1.0 / (0.01 * sampleRate));
+  reset();
+}
+
+void ThreeBandCrossover::reset() {
+  state = {};
+  startFaded = true;
+}
+
+void ThreeBandCrossover::clearSections(
+    std::initializer_list<Section> sections) {
+  for (auto section : sections)
+    state[(size_t)section] = {};
+}
+
+void ThreeBandCrossover::copyChannelState(int from, int to) {
+  jassert(juce::isPositiveAndBelow(from, maxChannels) &&
+          juce::isPositiveAndBelow(to, maxChannels));
+  for (auto &section : state)
+    for (auto &states : section)
+      states[(size_t)to] = states[(size_t)from];
+}
+
+ThreeBandCrossover::Coefficients
+ThreeBandCrossover::makeCoefficients(double frequency, double rate) {
+  // As in juce::dsp::LinkwitzRileyFilter::update()
+  const auto g =
+      (float)std::tan(juce::MathConstants<double>::pi * frequency / rate);
+  return {g, (float)(1.0 / (1.0 + R2 * g + g * g))};
+}
+
+void ThreeBandCrossover::setCutoffs(float lowFrequency, float highFrequency) {
+  if (lowFrequency != lowCutoff) {
+    low = makeCoefficients(lowFrequency, sampleRate);
+    lowCutoff = lowFrequency;
+  }
+  if (highFrequency != highCutoff) {
+    high = makeCoefficients(highFrequency, sampleRate);
+    highCutoff = highFrequency;
+  }
+}
+
+void ThreeBandCrossover::process(float *const *channels, int numChannels,
+                                 int numSamples,
+                                 const BandSettings &settings) {
+  jassert(numChannels <= maxChannels);
+  numChannels = juce::jmin(numChannels, maxChannels);
+
+  // Both bands off: allpass path, unless a crossfade is running
+  const bool split = settings.lowEnable || settings.highEnable;
+  const float target = split ? 1.0f : 0.0f;
+  if (startFaded) {
+    bandsGain = target;
+    startFaded = false;
+  }
+
+  if (bandsGain != target) {
+    // The path fading in starts from silence (the f1 section is shared)
+    if (bandsGain == 0.0f)
+      clearSections({low2, mid1, mid2, mid3, high1, high2});
+    else if (bandsGain == 1.0f)
+      clearSections({allpass2});
+
+    if (settings.lowEnable && settings.highEnable)
+      runBands<true, true, true>(channels, numChannels, numSamples, settings);
+    else if (settings.lowEnable)
+      runBands<true, false, true>(channels, numChannels, numSamples, settings);
+    else if (settings.highEnable)
+      runBands<false, true, true>(channels, numChannels, numSamples, settings);
+    else
+      runBands<false, false, true>(channels, numChannels, numSamples,
+                                   settings);
+  } else if (!split) {
+    if (numChannels == 2)
+      processAllpassStereo(channels, numSamples);
+    else
+      processAllpass(channels, numChannels, numSamples);
+  } else if (settings.lowEnable && settings.highEnable) {
+    // The band switches are picked once per block
+    runBands<true, true, false>(channels, numChannels, numSamples, settings);
+  } else if (settings.lowEnable) {
+    runBands<true, false, false>(channels, numChannels, numSamples, settings);
+  } else {
+    runBands<false, true, false>(channels, numChannels, numSamples, settings);
+  }
+
+  // Like juce::dsp::LinkwitzRileyFilter::snapToZero()
+  for (auto &section : state)
+    for (auto &states : section)
+      for (auto &s : states)
+        juce::dsp::util::snapToZero(s);
+}
+
+template <bool lowEnable, bool highEnable, bool fade>
+void ThreeBandCrossover::processBands(float *const *channels, int numChannels,
+                                      int numSamples,
+                                      const BandSettings &settings) {
+  const float gL = low.g, hL = low.h;
+  const float gH = high.g, hH = high.h;
+
+  // Local copy of the state: the compiler can then keep it in registers,
+  // as it cannot alias the audio
+  auto local = state;
+  const float target = lowEnable || highEnable ? 1.0f : 0.0f;
+  float gain = bandsGain;
+
+  for (int i = 0; i < numSamples; ++i) {
+    if constexpr (fade)
+      gain = target > gain ? juce::jmin(target, gain + fadeStep)
+                           : juce::jmax(target, gain - fadeStep);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+      auto s = [&](Section section, int which) -> float & {
+        return local[(size_t)section][(size_t)which][(size_t)channel];
+      };
+      const float x = channels[channel][i];
+
+      // f1: one shared first section, then the low and mid branches
+      const auto split = tick(x, gL, hL, s(split1, 0), s(split1, 1));
+      float lowBand = tick(split.low, gL, hL, s(low2, 0), s(low2, 1)).low;
+      float midBand = tick(split.high, gL, hL, s(mid1, 0), s(mid1, 1)).high;
+
+      // f2: LP on the mid band, HP on the input
+      midBand = tick(midBand, gH, hH, s(mid2, 0), s(mid2, 1)).low;
+      midBand = tick(midBand, gH, hH, s(mid3, 0), s(mid3, 1)).low;
+      float highBand = tick(x, gH, hH, s(high1, 0), s(high1, 1)).high;
+      highBand = tick(highBand, gH, hH, s(high2, 0), s(high2, 1)).high;
+
+      if constexpr (lowEnable)
+        lowBand = (lowBand + lowBand * std::abs(lowBand) * settings.lowWarmth) *
+                  (settings.lowLevelRamp != nullptr ? settings.lowLevelRamp[i]
+                                                    : settings.lowLevel);
+      if constexpr (highEnable)
+        highBand =
+            (highBand - settings.tanh(highBand * settings.highSoftness)) *
+            (settings.highLevelRamp != nullptr ? settings.highLevelRamp[i]
+                                               : settings.highLevel);
+
+      const float sum = lowBand + midBand + highBand;
+      if constexpr (fade) {
+        const float allpass =
+            tick(split.allpass(), gH, hH, s(allpass2, 0), s(allpass2, 1))
+                .allpass();
+        channels[channel][i] = allpass + (sum - allpass) * gain;
+      } else {
+        channels[channel][i] = sum;
+      }
+    }
+  }
+
+  bandsGain = gain;
+  state = local;
+}
+
+void ThreeBandCrossover::processAllpass(float *const *channels,
+                                        int numChannels, int numSamples) {
+  const float gL = low.g, hL = low.h;
+  const float gH = high.g, hH = high.h;
+  auto local = state;
+
+  for (int i = 0; i < numSamples; ++i) {
+    for (int channel = 0; channel < numChannels; ++channel) {
+      auto &first = local[(size_t)split1];
+      auto &second = local[(size_t)allpass2];
+      const float x = channels[channel][i];
+      const float y =
+          tick(x, gL, hL, first[0][(size_t)channel], first[1][(size_t)channel])
+              .allpass();
+      channels[channel][i] = tick(y, gH, hH, second[0][(size_t)channel],
+                                  second[1][(size_t)channel])
+                                 .allpass();
+    }
+  }
+
+  state = local;
+}
+
+template <bool lowEnable, bool highEnable, bool fade>
+void ThreeBandCrossover::runBands(float *const *channels, int numChannels,
+                                  int numSamples,
+                                  const BandSettings &settings) {
+  if (numChannels == 2)
+    processBandsStereo<lowEnable, highEnable, fade>(channels, numSamples,
+                                                    settings);
+  else
+    processBands<lowEnable, highEnable, fade>(channels, numChannels,
+                                              numSamples, settings);
+}
+
+//==============================================================================
+// Stereo paths: the sections of one frame are grouped in pairs, and each
+// pair runs both channels in one SIMD tick.
+
+namespace {
+
+using State = std::array<std::array<std::array<float, 2>, 2>, 8>;
+
+// s1 (which = 0) or s2 (which = 1) of two sections, {left, right} each
+Reg loadState(const State &state, int lowHalf, int highHalf, int which) {
+  const auto &a = state[(size_t)lowHalf][(size_t)which];
+  const auto &b = state[(size_t)highHalf][(size_t)which];
+  return Lanes::set(a[0], a[1], b[0], b[1]);
+}
+
+void storeState(State &state, int lowHalf, int highHalf, int which,
+                Reg value) {
+  float lanes[4];
+  Lanes::store(lanes, value);
+  if (lowHalf >= 0)
+    state[(size_t)lowHalf][(size_t)which] = {lanes[0], lanes[1]};
+  if (highHalf >= 0)
+    state[(size_t)highHalf][(size_t)which] = {lanes[2], lanes[3]};
+}
+
+} // namespace
+
+template <bool lowEnable, bool highEnable, bool fade>
+void ThreeBandCrossover::processBandsStereo(float *const *channels,
+                                            int numSamples,
+                                            const BandSettings &settings) {
+  static_assert(std::is_same_v<decltype(state), State>);
+  using L = Lanes;
+
+  // Four ticks per frame: {split1, high1}, {mid1, high2}, {mid2, low2} and
+  // {mid3, allpass2}
+  const LaneCoefficients lowHigh(low.g, low.h, high.g, high.h);
+  const LaneCoefficients highLow(high.g, high.h, low.g, low.h);
+  const LaneCoefficients highHigh(high.g, high.h, high.g, high.h);
+
+  Reg a1 = loadState(state, split1, high1, 0);
+  Reg a2 = loadState(state, split1, high1, 1);
+  Reg b1 = loadState(state, mid1, high2, 0);
+  Reg b2 = loadState(state, mid1, high2, 1);
+  Reg c1 = loadState(state, mid2, low2, 0);
+  Reg c2 = loadState(state, mid2, low2, 1);
+  Reg d1 = loadState(state, mid3, allpass2, 0);
+  Reg d2 = loadState(state, mid3, allpass2, 1);
+
+  const Reg warmth = L::pair(settings.lowWarmth, settings.lowWarmth);
+  Reg lowLevel = L::pair(settings.lowLevel, settings.lowLevel);
+  float highLevel = settings.highLevel;
+  const float target = lowEnable || highEnable ? 1.0f : 0.0f;
+  float gain = bandsGain;
+  float *left = channels[0];
+  float *right = channels[1];
+
+  for (int i = 0; i < numSamples; ++i) {
+    if constexpr (fade)
+      gain = target > gain ? juce::jmin(target, gain + fadeStep)
+                           : juce::jmax(target, gain - fadeStep);
+
+    const auto first = tick(L::pair(left[i], right[i]), lowHigh, a1, a2);
+    const auto second = tick(first.high, lowHigh, b1, b2);
+    const auto third = tick(L::lowHalves(second.high, first.low), highLow, c1, c2);
+    // The f2 allpass only runs while fading, on the f1 allpass
+    const auto fourth = tick(
+        L::lowHalves(third.low, fade ? first.allpass() : first.low), highHigh,
+        d1, d2);
+
+    // Bands in the low half
+    Reg lowBand = L::highHalf(third.low);
+    const Reg midBand = fourth.low;
+    Reg highBand = L::highHalf(second.high);
+
+    // Band levels, per sample while they glide
+    if (settings.lowLevelRamp != nullptr)
+      lowLevel = L::pair(settings.lowLevelRamp[i], settings.lowLevelRamp[i]);
+    if (settings.highLevelRamp != nullptr)
+      highLevel = settings.highLevelRamp[i];
+
+    if constexpr (lowEnable)
+      lowBand = L::mul(L::add(lowBand, L::mul(L::mul(lowBand, L::abs(lowBand)),
+                                              warmth)),
+                       lowLevel);
+    if constexpr (highEnable) {
+      const float highLeft = L::get0(highBand);
+      const float highRight = L::get1(highBand);
+      highBand = L::pair(
+          (highLeft - settings.tanh(highLeft * settings.highSoftness)) *
+              highLevel,
+          (highRight - settings.tanh(highRight * settings.highSoftness)) *
+              highLevel);
+    }
+
+    Reg sum = L::add(L::add(lowBand, midBand), highBand);
+    if constexpr (fade) {
+      const Reg allpass = L::highHalf(fourth.allpass());
+      sum = L::add(allpass, L::mul(L::sub(sum, allpass), L::pair(gain, gain)));
+    }
+    left[i] = L::get0(sum);
+    right[i] = L::get1(sum);
+  }
+
+  storeState(state, split1, high1, 0, a1);
+  storeState(state, split1, high1, 1, a2);
+  storeState(state, mid1, high2, 0, b1);
+  storeState(state, mid1, high2, 1, b2);
+  storeState(state, mid2, low2, 0, c1);
+  storeState(state, mid2, low2, 1, c2);
+  storeState(state, mid3, fade ? allpass2 : -1, 0, d1);
+  storeState(state, mid3, fade ? allpass2 : -1, 1, d2);
+  bandsGain = gain;
+}
+
+void ThreeBandCrossover::processAllpassStereo(float *const *channels,
+                                              int numSamples) {
+  using L = Lanes;
+
+  // Both channels in the low half; the high half runs the same ticks on a
+  // copy and is not used
+  const LaneCoefficients lowLow(low.g, low.h, low.g, low.h);
+  const LaneCoefficients highHigh(high.g, high.h, high.g, high.h);
+  Reg a1 = loadState(state, split1, split1, 0);
+  Reg a2 = loadState(state, split1, split1, 1);
+  Reg b1 = loadState(state, allpass2, allpass2, 0);
+  Reg b2 = loadState(state, allpass2, allpass2, 1);
+  float *left = channels[0];
+  float *right = channels[1];
+
+  for (int i = 0; i < numSamples; ++i) {
+    const Reg y = tick(L::pair(left[i], right[i]), lowLow, a1, a2).allpass();
+    const Reg out = tick(y, highHigh, b1, b2).allpass();
+    left[i] = L::get0(out);
+    right[i] = L::get1(out);
+  }
+
+  storeState(state, split1, -1, 0, a1);
+  storeState(state, split1, -1, 1, a2);
+  storeState(state, allpass2, -1, 0, b1);
+  storeState(state, allpass2, -1, 1, b2);
+}
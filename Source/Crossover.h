@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    -----------
+    Fused 3-band Linkwitz-Riley crossover with the band stages.
+
+    Role:
+    Same bands as four juce::dsp::LinkwitzRileyFilter (4th order, TPT):
+
+      low  = LP(f1)
+      mid  = LP(f2) after HP(f1)
+      high = HP(f2)
+
+    but computed in a single pass over each sample frame, with the Low
+    Warmth / High Softness curves, the band levels and the sum of the three
+    bands done in the same pass, in place. The LP(f1) and HP(f1) filters
+    share their first section (same input, same cutoff), so 7 sections run
+    instead of 8. The output matches the separate filters to float rounding
+    (see "steverator_bench --crossover").
+
+    The filter state of both channels sits in one array, channel-minor, so
+    a stereo frame touches one cache line.
+
+    The filters are recursive, so they cannot be vectorized along time.
+    Stereo blocks instead run both channels in SIMD lanes (SSE2 / NEON,
+    plain floats elsewhere): the sections of a frame are paired so that
+    one 4-lane tick advances two sections of both channels, and the 7
+    sections take 4 ticks. Mono blocks take the per-channel loop. Both
+    give the same output.
+
+    With both bands off the split is not needed: the bands would only be
+    summed back. The input then goes through a 2nd-order allpass at each
+    cutoff instead (2 sections instead of 7). The summed bands have
+    nearly the same phase response (exactly it for a 2-band split; the
+    bench reports the difference), so switching a band does not move the
+    sound in time.
+    Switching between the two paths crossfades over ~10 ms; the path that
+    fades in starts from a cleared state.
+
+    The low band is not run at a decimated rate. Its only stage (Low
+    Warmth and the level) costs three multiplies per sample inside the
+    fused pass, while decimating and interpolating it back would take
+    two more filters per sample, and its LP(f1) sections share their
+    first section with the mid band, so they cannot move to a lower rate
+    either. x|x| also makes harmonics well above f1, which a decimated
+    rate would alias. "steverator_bench --crossover" shows what the band
+    stages cost (Low only vs both bands off).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FastMath.h"
+#include <JuceHeader.h>
+#include <array>
+
+class ThreeBandCrossover {
+public:
+  static constexpr int maxChannels = 2;
+
+  // What happens to each band before the bands are summed
+  struct BandSettings {
+    bool lowEnable = false;
+    float lowWarmth = 0.0f;
+    float lowLevel = 1.0f; // gain
+    bool highEnable = false;
+    float highSoftness = 0.0f;
+    float highLevel = 1.0f; // gain
+    // Per-sample levels while Low / High Level glide (nullptr: the
+    // constants above)
+    const float *lowLevelRamp = nullptr;
+    const float *highLevelRamp = nullptr;
+    FastMath::ScalarFunction tanh = FastMath::getTanhFunction(
+        FastMath::Tier::Exact);
+  };
+
+  void prepare(double newSampleRate);
+  void reset();
+
+  // Recomputes the coefficients if a cutoff moved
+  void setCutoffs(float lowFrequency, float highFrequency);
+
+  // Splits, processes and sums the bands of up to maxChannels channels,
+  // in place
+  void process(float *const *channels, int numChannels, int numSamples,
+               const BandSettings &settings);
+
+  // Gives channel `to` the filter state of channel `from` (after blocks in
+  // which only `from` was processed)
+  void copyChannelState(int from, int to);
+
+private:
+  // One 2nd-order TPT section: g, and h = 1 / (1 + R2 g + g^2)
+  struct Coefficients {
+    float g = 0.0f;
+    float h = 1.0f;
+  };
+
+  // Sections, in the order they run
+  enum Section : int {
+    split1,  // shared first section of LP(f1) and HP(f1), also the f1
+             // allpass
+    low2,    // second section of LP(f1)
+    mid1,    // second section of HP(f1)
+    mid2,    // LP(f2), first section
+    mid3,    // LP(f2), second section
+    high1,   // HP(f2), first section
+    high2,   // HP(f2), second section
+    allpass2, // f2 allpass (bands off)
+    numSections
+  };
+
+  // fade: crossfades from the allpass path to the split (bandsGain going
+  // to 1) or back (going to 0)
+  template <bool lowEnable, bool highEnable, bool fade>
+  void processBands(float *const *channels, int numChannels, int numSamples,
+                    const BandSettings &settings);
+  void processAllpass(float *const *channels, int numChannels,
+                      int numSamples);
+
+  // The same, both channels of a stereo block at once, in SIMD lanes
+  template <bool lowEnable, bool highEnable, bool fade>
+  void processBandsStereo(float *const *channels, int numSamples,
+                          const BandSettings &settings);
+  void processAllpassStereo(float *const *channels, int numSamples);
+
+  // Picks the stereo or the per-channel version
+  template <bool lowEnable, bool highEnable, bool fade>
+  void runBands(float *const *channels, int numChannels, int numSamples,
+                const BandSettings &settings);
+  void clearSections(std::initializer_list<Section> sections);
+
+  static Coefficients makeCoefficients(double frequency, double sampleRate);
+
+  double sampleRate = 44100.0;
+  float lowCutoff = -1.0f;
+  float highCutoff = -1.0f;
+  Coefficients low, high;
+
+  // 0 = allpass path, 1 = split, in between while crossfading
+  float bandsGain = 0.0f;
+  float fadeStep = 1.0f;
+  bool startFaded = true; // no crossfade on the first block after reset()
+
+  // state[section][s1 / s2][channel]
+  std::array<std::array<std::array<float, maxChannels>, 2>, numSections>
+      state{};
+};
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    DeadlineMonitor.h
+    -----------------
+    processBlock() durations against their real-time deadline, for DevTools.
+
+    Role:
+    cpuUsage is a moving average, which hides the single slow blocks that
+    cause dropouts. The processor also hands every block to a
+    DeadlineMonitor, which records the block's load (its duration divided
+    by numSamples / sampleRate) in a TimingHistogram, in parts per million
+    of the deadline. It counts the blocks that missed their deadline (load
+    above 1) and keeps the slowest block so far, with the parameter values
+    it was processed with.
+
+    Everything is lock-free. The worst block is published with a sequence
+    counter: the audio thread makes it odd while it writes, and readers
+    retry until they copied the fields under the same even value.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "ParameterSnapshot.h"
+#include "TimingHistogram.h"
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <thread>
+
+class DeadlineMonitor {
+public:
+  struct WorstBlock {
+    double load = 0.0; // duration / deadline
+    double seconds = 0.0;
+    int numSamples = 0;
+    std::array<float, Params::numIds> parameters{}; // raw values
+  };
+
+  //==============================================================================
+  // Audio thread
+  void addBlock(double seconds, double deadlineSeconds, int numSamples,
+                const ParameterSnapshot &parameters) noexcept {
+    const auto relaxed = std::memory_order_relaxed;
+    const double load = seconds / deadlineSeconds;
+    loads.add((juce::uint64)(load * 1.0e6));
+    if (load > 1.0)
+      overruns.store(overruns.load(relaxed) + 1, relaxed);
+
+    if (load > worstLoad) {
+      worstLoad = load;
+      const auto version = worstVersion.load(relaxed);
+      worstVersion.store(version + 1, relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      worst.load.store(load, relaxed);
+      worst.seconds.store(seconds, relaxed);
+      worst.numSamples.store(numSamples, relaxed);
+      for (int i = 0; i < Params::numIds; ++i)
+        worst.parameters[(size_t)i].store(parameters.get((Params::Id)i),
+                                          relaxed);
+      worstVersion.store(version + 2, std::memory_order_release);
+    }
+  }
+
+  // Only while the audio thread is stopped (prepareToPlay())
+  void reset() noexcept {
+    loads.reset();
+    overruns.store(0, std::memory_order_relaxed);
+    worstLoad = 0.0;
+    worstVersion.store(worstVersion.load() + 2);
+    worst.load.store(0.0);
+    worst.seconds.store(0.0);
+    worst.numSamples.store(0);
+  }
+
+  //==============================================================================
+  // Readers (any thread)
+
+  // Block loads, in parts per million of the deadline
+  TimingHistogram::Snapshot getLoads() const { return loads.getSnapshot(); }
+
+  juce::int64 getNumOverruns() const {
+    return overruns.load(std::memory_order_relaxed);
+  }
+
+  WorstBlock getWorstBlock() const {
+    WorstBlock copy;
+    for (;;) {
+      const auto before = worstVersion.load(std::memory_order_acquire);
+      if ((before & 1) == 0) {
+        copy.load = worst.load.load(std::memory_order_relaxed);
+        copy.seconds = worst.seconds.load(std::memory_order_relaxed);
+        copy.numSamples = worst.numSamples.load(std::memory_order_relaxed);
+        for (int i = 0; i < Params::numIds; ++i)
+          copy.parameters[(size_t)i] =
+              worst.parameters[(size_t)i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (worstVersion.load(std::memory_order_relaxed) == before)
+          return copy;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  TimingHistogram loads;
+  std::atomic<juce::int64> overruns{0};
+
+  double worstLoad = 0.0; // audio thread only
+  std::atomic<juce::uint32> worstVersion{0};
+  struct {
+    std::atomic<double> load{0.0}, seconds{0.0};
+    std::atomic<int> numSamples{0};
+    std::array<std::atomic<float>, Params::numIds> parameters{};
+  } worst;
+};
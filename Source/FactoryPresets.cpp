@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+    FactoryPresets.cpp
+    ------------------
+    The preset table and how a preset is applied (see FactoryPresets.h).
+
+  ==============================================================================
+*/
+
+#include "FactoryPresets.h"
+
+namespace FactoryPresets {
+
+std::vector<Preset> create() {
+  std::vector<Preset> presets;
+
+  // ============ CLASSICS (1-6) ============
+  presets.push_back({"Warm Tape", 16, 6.0f, 0.4f, 0.0f, 75.0f, 0.0f, true,
+                     120.0f, 0.5f, 2.0f, true, 4000.0f, 0.6f, 1.0f, true,
+                     false});
+  presets.push_back({"Tube Glow", 1, 8.0f, 0.3f, 0.0f, 80.0f, -1.0f, true,
+                     100.0f, 0.6f, 3.0f, true, 6000.0f, 0.4f, 2.0f, true,
+                     false});
+  presets.push_back({"Soft Clip", 2, 5.0f, 0.5f, 0.0f, 70.0f, 0.0f, false,
+                     80.0f, 0.3f, 0.0f, false, 3000.0f, 0.5f, 0.0f, false,
+                     false});
+  presets.push_back({"Vintage Console", 1, 4.0f, 0.2f, 2.0f, 60.0f, -2.0f, true,
+                     150.0f, 0.4f, 1.5f, true, 8000.0f, 0.7f, 1.0f, true,
+                     true});
+  presets.push_back({"Analog Warmth", 18, 3.0f, 0.3f, 0.0f, 50.0f, 0.0f, true,
+                     100.0f, 0.5f, 2.0f, true, 5000.0f, 0.5f, 1.5f, false,
+                     false});
+  presets.push_back({"Classic Overdrive", 17, 10.0f, 0.4f, 0.0f, 85.0f, -2.0f,
+                     true, 80.0f, 0.3f, 1.0f, true, 4500.0f, 0.3f, 1.5f, true,
+                     false});
+
+  // ============ MUSIC STYLES (7-12) ============
+  presets.push_back({"Hip-Hop Low End", 1, 7.0f, 0.2f, 3.0f, 65.0f, 0.0f, true,
+                     200.0f, 0.8f, 4.0f, false, 2000.0f, 0.5f, 0.0f, true,
+                     false});
+  presets.push_back({"EDM Punch", 3, 12.0f, 0.6f, 2.0f, 90.0f, -3.0f, true,
+                     100.0f, 0.4f, 3.0f, true, 6000.0f, 0.2f, 2.5f, true,
+                     true});
+  presets.push_back({"Rock Crunch", 17, 14.0f, 0.5f, 0.0f, 100.0f, -4.0f, true,
+                     150.0f, 0.3f, 2.0f, true, 5000.0f, 0.3f, 2.0f, true,
+                     false});
+  presets.push_back({"Jazz Warmth", 1, 3.0f, 0.2f, 0.0f, 40.0f, 0.0f, true,
+                     80.0f, 0.6f, 1.5f, true, 7000.0f, 0.8f, 0.5f, false,
+                     false});
+  presets.push_back({"Lo-Fi Beats", 9, 8.0f, 0.7f, -2.0f, 70.0f, 0.0f, true,
+                     300.0f, 0.6f, 2.0f, true, 3000.0f, 0.9f, -1.0f, false,
+                     true});
+  presets.push_back({"Metal Aggression", 3, 20.0f, 0.8f, 4.0f, 100.0f, -6.0f,
+                     true, 120.0f, 0.2f, 3.0f, true, 4000.0f, 0.1f, 3.5f, true,
+                     true});
+
+  // ============ INSTRUMENTS (13-20) ============
+  presets.push_back({"Bass Growl", 4, 9.0f, 0.4f, 2.0f, 80.0f, -1.0f, true,
+                     250.0f, 0.7f, 4.0f, false, 1500.0f, 0.6f, 0.0f, true,
+                     false});
+  presets.push_back({"Vocal Warmth", 18, 4.0f, 0.3f, 0.0f, 45.0f, 1.0f, false,
+                     100.0f, 0.4f, 0.0f, true, 8000.0f, 0.7f, 1.0f, false,
+                     true});
+  presets.push_back({"Drums Punch", 2, 8.0f, 0.5f, 3.0f, 75.0f, -2.0f, true,
+                     80.0f, 0.3f, 2.5f, true, 6000.0f, 0.4f, 2.0f, true, true});
+  presets.push_back({"Guitar Amp", 15, 11.0f, 0.6f, 0.0f, 90.0f, -3.0f, true,
+                     100.0f, 0.4f, 1.5f, true, 5000.0f, 0.3f, 2.5f, true,
+                     false});
+  presets.push_back({"Synth Edge", 12, 7.0f, 0.7f, 1.0f, 70.0f, 0.0f, true,
+                     60.0f, 0.2f, 1.0f, true, 7000.0f, 0.3f, 3.0f, false,
+                     true});
+  presets.push_back({"Piano Glue", 1, 2.5f, 0.2f, 0.0f, 35.0f, 0.0f, true,
+                     100.0f, 0.4f, 1.0f, true, 6000.0f, 0.6f, 0.5f, false,
+                     false});
+  presets.push_back({"Strings Silk", 16, 3.0f, 0.3f, 0.0f, 40.0f, 0.5f, false,
+                     150.0f, 0.5f, 0.0f, true, 8000.0f, 0.8f, 1.0f, false,
+                     false});
+  presets.push_back({"Horns Presence", 1, 5.0f, 0.4f, 1.0f, 55.0f, 0.0f, true,
+                     200.0f, 0.3f, 1.5f, true, 5000.0f, 0.4f, 2.0f, false,
+                     true});
+
+  // ============ CREATIVE / FX (21-26) ============
+  presets.push_back({"Bitcrushed", 9, 15.0f, 0.9f, 0.0f, 80.0f, -4.0f, false,
+                     100.0f, 0.5f, 0.0f, false, 4000.0f, 0.5f, 0.0f, true,
+                     true});
+  presets.push_back({"Fuzz Box", 4, 18.0f, 0.7f, 3.0f, 95.0f, -5.0f, true,
+                     80.0f, 0.5f, 2.0f, true, 3500.0f, 0.2f, 2.5f, true,
+                     false});
+  presets.push_back({"Wave Folder", 6, 10.0f, 0.6f, 0.0f, 85.0f, -3.0f, true,
+                     100.0f, 0.3f, 1.0f, true, 5000.0f, 0.4f, 1.5f, true,
+                     true});
+  presets.push_back({"Sin Fold", 7, 12.0f, 0.8f, 0.0f, 75.0f, -4.0f, true,
+                     120.0f, 0.4f, 1.5f, true, 6000.0f, 0.3f, 2.0f, true,
+                     false});
+  presets.push_back({"Rectifier", 11, 8.0f, 0.5f, 0.0f, 70.0f, -2.0f, true,
+                     100.0f, 0.4f, 2.0f, true, 4500.0f, 0.5f, 1.5f, true,
+                     true});
+  presets.push_back({"Extreme Destroy", 3, 24.0f, 1.0f, 6.0f, 100.0f, -8.0f,
+                     true, 50.0f, 0.2f, 4.0f, true, 3000.0f, 0.1f, 4.0f, true,
+                     true});
+
+  // ============ NEW CREATIVE (27-36) ============
+  presets.push_back({"Digital Grit", 18, 12.0f, 0.8f, 0.0f, 80.0f, -2.0f, true,
+                     100.0f, 0.3f, 1.0f, true, 5000.0f, 0.2f, 2.0f, true,
+                     false});
+  presets.push_back({"Glitchy Bass", 19, 9.0f, 0.4f, 2.0f, 85.0f, -1.0f, true,
+                     150.0f, 0.7f, 3.0f, true, 3000.0f, 0.5f, 0.5f, false,
+                     true});
+  presets.push_back({"Valve Master", 20, 4.5f, 0.3f, 0.0f, 40.0f, 0.0f, true,
+                     80.0f, 0.4f, 1.0f, true, 6000.0f, 0.8f, 0.5f, false,
+                     false});
+  presets.push_back({"Hard Fuzz", 21, 15.0f, 0.6f, 3.0f, 95.0f, -4.0f, true,
+                     200.0f, 0.2f, 2.0f, true, 4000.0f, 0.1f, 3.0f, true,
+                     true});
+  presets.push_back({"Harmonic Filter", 22, 7.0f, 0.5f, 0.0f, 60.0f, 0.0f, true,
+                     120.0f, 0.1f, 1.5f, true, 5500.0f, 0.4f, 2.0f, false,
+                     false});
+  presets.push_back({"Polished Sat.", 26, 6.0f, 0.2f, 0.0f, 50.0f, 0.0f, true,
+                     90.0f, 0.5f, 1.0f, true, 7500.0f, 0.7f, 0.5f, false,
+                     false});
+  presets.push_back({"Log Deep", 24, 10.0f, 0.4f, 1.0f, 70.0f, -2.0f, true,
+                     60.0f, 0.8f, 3.5f, false, 8000.0f, 0.5f, 0.0f, true,
+                     false});
+  presets.push_back({"Half Vintage", 25, 8.0f, 0.3f, 0.0f, 45.0f, 0.0f, true,
+                     110.0f, 0.4f, 1.5f, true, 4500.0f, 0.6f, 1.2f, false,
+                     true});
+  presets.push_back({"Octave Dirt", 27, 14.0f, 0.6f, 2.0f, 80.0f, -3.0f, true,
+                     70.0f, 0.3f, 2.0f, true, 5000.0f, 0.2f, 2.5f, true, true});
+  presets.push_back({"Pentode Drive", 20, 11.0f, 0.7f, 1.0f, 90.0f, -3.0f, true,
+                     150.0f, 0.4f, 2.5f, true, 4000.0f, 0.3f, 2.0f, true,
+                     false});
+
+  // ============ MASTERING / SUBTLE (37-40) ============
+  presets.push_back({"Master Glue", 18, 2.0f, 0.15f, 0.0f, 25.0f, 0.0f, true,
+                     80.0f, 0.4f, 0.5f, true, 10000.0f, 0.7f, 0.5f, true,
+                     false});
+  presets.push_back({"Parallel Crush", 2, 12.0f, 0.5f, 0.0f, 30.0f, 0.0f, true,
+                     100.0f, 0.5f, 2.0f, true, 5000.0f, 0.4f, 1.5f, true,
+                     true});
+  presets.push_back({"Subtle Harmonics", 1, 1.5f, 0.1f, 0.0f, 20.0f, 0.5f, true,
+                     100.0f, 0.3f, 0.5f, true, 8000.0f, 0.6f, 0.5f, false,
+                     false});
+  presets.push_back({"Bus Warmth", 16, 4.0f, 0.25f, 0.0f, 40.0f, -0.5f, true,
+                     120.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
+                     false});
+
+  // ============ NEW: DECAPITATOR STYLE (41-48) ============
+  presets.push_back({"Punish (A)", 28, 16.0f, 0.7f, 4.0f, 100.0f, -5.0f, true,
+                     100.0f, 0.3f, 2.5f, true, 4000.0f, 0.2f, 3.0f, true,
+                     true}); // Triode aggressive
+  presets.push_back({"Pentode Power", 29, 12.0f, 0.5f, 2.0f, 85.0f, -3.0f, true,
+                     150.0f, 0.4f, 2.0f, true, 5000.0f, 0.3f, 2.5f, true,
+                     false}); // Pentode classic
+  presets.push_back({"Class A Warmth", 30, 6.0f, 0.3f, 0.0f, 60.0f, 0.0f, true,
+                     80.0f, 0.6f, 1.5f, true, 8000.0f, 0.7f, 1.0f, false,
+                     false}); // Single-ended smooth
+  presets.push_back({"Push-Pull Punch", 31, 10.0f, 0.5f, 3.0f, 80.0f, -2.0f,
+                     true, 120.0f, 0.3f, 2.5f, true, 5500.0f, 0.4f, 2.0f, true,
+                     true}); // Class AB power
+  presets.push_back({"Germanium Fuzz", 33, 14.0f, 0.6f, 2.0f, 90.0f, -4.0f,
+                     true, 200.0f, 0.2f, 3.0f, true, 3500.0f, 0.15f, 3.5f, true,
+                     false}); // Vintage fuzz
+  presets.push_back({"Triode Clean", 28, 3.0f, 0.2f, 0.0f, 35.0f, 0.5f, true,
+                     100.0f, 0.4f, 1.0f, true, 9000.0f, 0.8f, 0.5f, false,
+                     false}); // Subtle tube
+  presets.push_back({"Hot Pentode", 29, 18.0f, 0.8f, 5.0f, 95.0f, -6.0f, true,
+                     80.0f, 0.2f, 3.5f, true, 4000.0f, 0.1f, 4.0f, true,
+                     true}); // Pushed hard
+  presets.push_back({"Class B Grit", 32, 8.0f, 0.4f, 0.0f, 70.0f, -1.0f, true,
+                     100.0f, 0.3f, 1.5f, true, 6000.0f, 0.5f, 1.5f, true,
+                     false}); // Crossover character
+
+  // ============ NEW: SATURN TAPE STYLE (49-56) ============
+  presets.push_back({"Tape Machine 15", 34, 5.0f, 0.3f, 0.0f, 55.0f, 0.0f, true,
+                     100.0f, 0.5f, 1.0f, true, 12000.0f, 0.6f, 0.5f, false,
+                     false}); // Fast bright tape
+  presets.push_back({"Tape Machine 7.5", 35, 7.0f, 0.4f, 0.0f, 65.0f, 0.0f,
+                     true, 80.0f, 0.7f, 2.0f, true, 6000.0f, 0.8f, 1.0f, false,
+                     false}); // Slow warm tape
+  presets.push_back({"Lo-Fi Cassette", 36, 10.0f, 0.6f, -1.0f, 75.0f, 0.0f,
+                     true, 250.0f, 0.5f, 2.5f, true, 4000.0f, 0.9f, -1.0f,
+                     false, true}); // Cassette vibes
+  presets.push_back({"Ampex 456", 37, 8.0f, 0.5f, 2.0f, 70.0f, -1.0f, true,
+                     150.0f, 0.6f, 3.0f, true, 7000.0f, 0.5f, 1.5f, true,
+                     false}); // Punchy 456
+  presets.push_back({"Modern Tape", 38, 4.0f, 0.25f, 0.0f, 45.0f, 0.0f, true,
+                     100.0f, 0.4f, 1.0f, true, 10000.0f, 0.7f, 0.5f, false,
+                     false}); // SM900 clean
+  presets.push_back({"Tape Slam", 37, 15.0f, 0.7f, 4.0f, 90.0f, -4.0f, true,
+                     80.0f, 0.4f, 3.5f, true, 5000.0f, 0.3f, 3.0f, true,
+                     true}); // Driven tape
+  presets.push_back({"Tape + Tube", 34, 6.0f, 0.4f, 1.0f, 60.0f, 0.0f, true,
+                     120.0f, 0.5f, 2.0f, true, 8000.0f, 0.6f, 1.5f, false,
+                     true}); // Combined flavor
+  presets.push_back({"Vintage Deck", 35, 9.0f, 0.5f, 0.0f, 70.0f, -1.0f, true,
+                     100.0f, 0.6f, 2.5f, true, 5000.0f, 0.7f, 1.0f, true,
+                     false}); // Reel-to-reel
+
+  // ============ NEW: CONSOLE / TRANSFORMER (57-62) ============
+  presets.push_back({"Neve Console", 40, 5.0f, 0.3f, 1.0f, 50.0f, 0.0f, true,
+                     100.0f, 0.5f, 1.5f, true, 8000.0f, 0.6f, 1.0f, false,
+                     false}); // Neve warmth
+  presets.push_back({"API Punch", 41, 8.0f, 0.5f, 2.0f, 70.0f, -1.0f, true,
+                     150.0f, 0.4f, 2.5f, true, 6000.0f, 0.4f, 2.0f, true,
+                     true}); // API character
+  presets.push_back({"SSL Sheen", 42, 4.0f, 0.25f, 0.0f, 40.0f, 0.5f, true,
+                     80.0f, 0.3f, 1.0f, true, 12000.0f, 0.5f, 0.5f, false,
+                     false}); // SSL clean
+  presets.push_back({"Iron Saturator", 39, 7.0f, 0.4f, 0.0f, 60.0f, 0.0f, true,
+                     100.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
+                     false}); // Transformer sat
+  presets.push_back({"Console Crunch", 40, 12.0f, 0.6f, 3.0f, 85.0f, -3.0f,
+                     true, 120.0f, 0.3f, 2.5f, true, 5000.0f, 0.3f, 2.5f, true,
+                     true}); // Pushed console
+  presets.push_back({"Vintage Desk", 39, 6.0f, 0.35f, 1.0f, 55.0f, 0.0f, true,
+                     100.0f, 0.6f, 2.0f, true, 6000.0f, 0.7f, 1.5f, false,
+                     false}); // Old school
+
+  // ============ NEW: MODERN PRODUCTION (63-68) ============
+  presets.push_back({"FET Vocal", 44, 4.0f, 0.3f, 0.0f, 45.0f, 0.0f, false,
+                     80.0f, 0.4f, 0.0f, true, 10000.0f, 0.6f, 0.5f, true,
+                     true}); // 1176 vocal
+  presets.push_back({"All Buttons In", 45, 12.0f, 0.7f, 3.0f, 80.0f, -3.0f,
+                     true, 100.0f, 0.3f, 2.0f, true, 5000.0f, 0.3f, 2.5f, true,
+                     true}); // 1176 slammed
+  presets.push_back({"Silicon Bass", 43, 9.0f, 0.4f, 3.0f, 75.0f, -1.0f, true,
+                     250.0f, 0.7f, 4.0f, false, 2000.0f, 0.5f, 0.0f, true,
+                     false}); // Transistor bass
+  presets.push_back({"OpAmp Drive", 46, 10.0f, 0.5f, 2.0f, 80.0f, -2.0f, true,
+                     100.0f, 0.4f, 2.0f, true, 6000.0f, 0.4f, 2.0f, true,
+                     true}); // IC character
+  presets.push_back({"Digital Hybrid", 47, 6.0f, 0.5f, 0.0f, 60.0f, 0.0f, true,
+                     80.0f, 0.3f, 1.0f, true, 8000.0f, 0.5f, 1.5f, false,
+                     false}); // CMOS blend
+  presets.push_back({"Parallel FET", 44, 8.0f, 0.4f, 0.0f, 35.0f, 0.0f, true,
+                     100.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
+                     true}); // Parallel compression
+
+  // ============ NEW: CREATIVE / SOUND DESIGN (69-76) ============
+  presets.push_back({"Screamer", 48, 16.0f, 0.8f, 4.0f, 95.0f, -5.0f, true,
+                     100.0f, 0.2f, 3.0f, true, 4000.0f, 0.1f, 3.5f, true,
+                     true}); // Aggressive scream
+  presets.push_back({"Buzz Saw", 49, 14.0f, 0.7f, 2.0f, 85.0f, -4.0f, true,
+                     80.0f, 0.3f, 2.0f, true, 5000.0f, 0.2f, 3.0f, true,
+                     false}); // Buzzy character
+  presets.push_back({"Vinyl Crackle", 50, 5.0f, 0.6f, -2.0f, 50.0f, 0.0f, true,
+                     200.0f, 0.4f, 1.0f, true, 4000.0f, 0.8f, -0.5f, false,
+                     false}); // Crackle texture
+  presets.push_back({"Wrap Around", 51, 10.0f, 0.5f, 0.0f, 75.0f, -2.0f, true,
+                     100.0f, 0.4f, 1.5f, true, 6000.0f, 0.4f, 2.0f, true,
+                     true}); // Wrap distortion
+  presets.push_back({"Dense Stack", 52, 8.0f, 0.4f, 2.0f, 70.0f, -1.0f, true,
+                     150.0f, 0.5f, 2.5f, true, 5500.0f, 0.5f, 2.0f, true,
+                     false}); // Thick density
+  presets.push_back({"Harmonic 7", 53, 6.0f, 0.5f, 0.0f, 55.0f, 0.0f, true,
+                     100.0f, 0.3f, 1.0f, true, 8000.0f, 0.5f, 1.0f, false,
+                     false}); // Chebyshev 7
+  presets.push_back({"Hyperbolic", 54, 7.0f, 0.4f, 0.0f, 60.0f, 0.0f, true,
+                     80.0f, 0.4f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
+                     false}); // Sinh character
+  presets.push_back({"Wavelet FX", 57, 8.0f, 0.6f, 0.0f, 65.0f, -1.0f, true,
+                     100.0f, 0.5f, 1.5f, true, 6000.0f, 0.5f, 1.5f, true,
+                     true}); // Wavelet texture
+
+  for (auto &preset : presets) {
+    preset.limiter = false;
+  }
+
+  return presets;
+}
+
+int findByName(const std::vector<Preset> &presets, const juce::String &name) {
+  for (size_t i = 0; i < presets.size(); ++i)
+    if (presets[i].name.equalsIgnoreCase(name.trim()))
+      return static_cast<int>(i);
+  return -1;
+}
+
+void apply(juce::AudioProcessorValueTreeState &apvts, const Preset &p) {
+  // Waveshape (ComboBox - 1-indexed)
+  if (auto *param = apvts.getParameter("waveshape"))
+    param->setValueNotifyingHost(
+        param->convertTo0to1(static_cast<float>(p.waveshape)));
+
+  // Global controls
+  if (auto *param = apvts.getParameter("drive"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.drive));
+  if (auto *param = apvts.getParameter("shape"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.shape));
+  if (auto *param = apvts.getParameter("inputGain"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.inputGain));
+  if (auto *param = apvts.getParameter("mix"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.mix));
+  if (auto *param = apvts.getParameter("output"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.outputGain));
+
+  // Low band
+  if (auto *param = apvts.getParameter("lowEnable"))
+    param->setValueNotifyingHost(p.lowEnable ? 1.0f : 0.0f);
+  if (auto *param = apvts.getParameter("lowFreq"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.lowFreq));
+  if (auto *param = apvts.getParameter("lowWarmth"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.lowWarmth));
+  if (auto *param = apvts.getParameter("lowLevel"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.lowLevel));
+
+  // High band
+  if (auto *param = apvts.getParameter("highEnable"))
+    param->setValueNotifyingHost(p.highEnable ? 1.0f : 0.0f);
+  if (auto *param = apvts.getParameter("highFreq"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.highFreq));
+  if (auto *param = apvts.getParameter("highSoftness"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.highSoftness));
+  if (auto *param = apvts.getParameter("highLevel"))
+    param->setValueNotifyingHost(param->convertTo0to1(p.highLevel));
+
+  // Routing
+  if (auto *param = apvts.getParameter("limiter"))
+    param->setValueNotifyingHost(p.limiter ? 1.0f : 0.0f);
+  if (auto *param = apvts.getParameter("prePost"))
+    param->setValueNotifyingHost(p.prePost ? 1.0f : 0.0f);
+}
+
+} // namespace FactoryPresets
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    FactoryPresets.h
+    ----------------
+    The factory presets of the Presets menu.
+
+    Role:
+    Holds the preset table and writes a preset into the parameters, so the
+    editor's Presets menu and steverator_render (which has no editor) share
+    them. A preset only sets the parameters it lists; the others keep
+    their value.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace FactoryPresets {
+
+struct Preset {
+  juce::String name;
+  int waveshape;    // 1-18
+  float drive;      // 0-24
+  float shape;      // 0-1
+  float inputGain;  // -24 to +24
+  float mix;        // 0-100
+  float outputGain; // -24 to +24
+  bool lowEnable;
+  float lowFreq;   // 20-500
+  float lowWarmth; // 0-1
+  float lowLevel;  // 0-12
+  bool highEnable;
+  float highFreq;     // 500-16000
+  float highSoftness; // 0-1
+  float highLevel;    // 0-12
+  bool limiter;
+  bool prePost;
+};
+
+// All presets, in menu order
+std::vector<Preset> create();
+
+// Index of the preset with this name (case-insensitive), or -1
+int findByName(const std::vector<Preset> &presets, const juce::String &name);
+
+// Sets the parameters of the preset (notifying the host)
+void apply(juce::AudioProcessorValueTreeState &apvts, const Preset &p);
+
+} // namespace FactoryPresets
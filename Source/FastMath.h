@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    ----------
+    Fast approximations of the transcendental functions used by the DSP.
+
+    Role:
+    exp, tanh, sin, atan, log, pow, sinh and cosh in three accuracy tiers,
+    written once for both scalar and SIMD code. Every function is a template
+    over Vec<Ops, Tier>, where Ops wraps the intrinsics of one instruction
+    set (ScalarOps below, or the per-ISA structs in SimdWaveshapers*.cpp)
+    and Tier picks the polynomial at compile time:
+
+      Exact  Cephes polynomials, within a few float ulps of std::.
+      High   Smaller minimax polynomials, inaudible difference.
+      Eco    Cheapest minimax polynomials, for large sessions and renders.
+
+    Maximum error against the standard library, over the ranges the
+    waveshapes use (see getErrorBounds(), checked by
+    "steverator_bench --accuracy"):
+
+      function   range                   Exact   High    Eco
+      exp        [-87, 88]               2e-7    4e-6    1.2e-4  relative
+      tanh       all x                   2e-7    2e-6    6e-5
+      sin        |x| <= 1e4              5e-7    1.5e-6  1e-4
+      atan       all x                   3e-7    2e-5    1e-3
+      log        [1e-3, 1e4]             1e-6    2e-5    1e-3
+      pow        x in [1e-3, 1e3],       4e-6    8e-5    4e-3    relative
+                 y in [0.1, 4]
+      sinh/cosh  |x| <= 20               3e-7    6e-6    1.6e-4  relative
+
+    Exact is not the standard library. The scalar Exact waveshapes (the
+    original code in Waveshapers.cpp) and getTanhFunction(Exact) call
+    std::, but the SIMD Exact kernels run these polynomials, and the
+    curves amplify their error: an Exact SIMD kernel differs from the
+    std:: kernel by about 1e-5 (-100 dB), up to exactKernelDeviation,
+    relative to max(1, |output|). They are close, not bit-identical.
+
+    The Ops struct must provide Reg, Mask, width, broadcast, load, store,
+    add, sub, mul, div, mulAdd (a * b + c), min, max, abs, sqrt, cmpGt,
+    cmpLt, select (mask ? a : b), signBits, orBits, xorBits, roundNearest,
+    exp2Int (2^n for an integral n in [-126, 127]) and frexp (mantissa in
+    [0.5, 1) plus exponent, like std::frexp).
+
+    Vec and the approximations live in FastMathVec.h, which includes
+    nothing, so that the translation units built with extra ISA flags
+    (AVX2, AVX-512) can use them without this header. Those units must
+    only instantiate the templates with their own anonymous-namespace Ops,
+    never with ScalarOps, or the linker could keep their copy for everyone.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FastMathVec.h"
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace FastMath {
+
+inline const char *getTierName(Tier tier) {
+  switch (tier) {
+  case Tier::Exact:
+    return "Exact";
+  case Tier::High:
+    return "High";
+  case Tier::Eco:
+    return "Eco";
+  }
+  return "Unknown";
+}
+
+// Documented maximum errors (see the table above)
+struct ErrorBounds {
+  double exp, tanh, sin, atan, log, pow, sinhCosh;
+};
+
+// Largest documented difference between an Exact SIMD waveshaper kernel
+// and the std:: based scalar one (see above)
+constexpr double exactKernelDeviation = 5e-5;
+
+constexpr ErrorBounds getErrorBounds(Tier tier) {
+  switch (tier) {
+  case Tier::Exact:
+    return {2e-7, 2e-7, 5e-7, 3e-7, 1e-6, 4e-6, 3e-7};
+  case Tier::High:
+    return {4e-6, 2e-6, 1.5e-6, 2e-5, 2e-5, 8e-5, 6e-6};
+  case Tier::Eco:
+    return {1.2e-4, 6e-5, 1e-4, 1e-3, 1e-3, 4e-3, 1.6e-4};
+  }
+  return {};
+}
+
+//==============================================================================
+// One float at a time, with the same semantics as the vector Ops.
+struct ScalarOps {
+  using Reg = float;
+  using Mask = bool;
+  static constexpr int width = 1;
+
+  static Reg broadcast(float x) { return x; }
+  static Reg load(const float *p) { return *p; }
+  static void store(float *p, Reg v) { *p = v; }
+
+  static Reg add(Reg a, Reg b) { return a + b; }
+  static Reg sub(Reg a, Reg b) { return a - b; }
+  static Reg mul(Reg a, Reg b) { return a * b; }
+  static Reg div(Reg a, Reg b) { return a / b; }
+  static Reg mulAdd(Reg a, Reg b, Reg c) { return a * b + c; }
+  static Reg min(Reg a, Reg b) { return b < a ? b : a; }
+  static Reg max(Reg a, Reg b) { return a < b ? b : a; }
+  static Reg abs(Reg a) { return std::abs(a); }
+  static Reg sqrt(Reg a) { return std::sqrt(a); }
+
+  static Mask cmpGt(Reg a, Reg b) { return a > b; }
+  static Mask cmpLt(Reg a, Reg b) { return a < b; }
+  static Reg select(Mask m, Reg a, Reg b) { return m ? a : b; }
+
+  static Reg signBits(Reg a) { return fromBits(toBits(a) & 0x80000000u); }
+  static Reg orBits(Reg a, Reg b) { return fromBits(toBits(a) | toBits(b)); }
+  static Reg xorBits(Reg a, Reg b) { return fromBits(toBits(a) ^ toBits(b)); }
+
+  static Reg roundNearest(Reg a) { return std::nearbyint(a); }
+  static Reg exp2Int(Reg n) {
+    return fromBits(static_cast<uint32_t>(static_cast<int32_t>(n) + 127)
+                    << 23);
+  }
+  static Reg frexp(Reg x, Reg &exponent) {
+    const uint32_t bits = toBits(x);
+    exponent = static_cast<float>(static_cast<int32_t>((bits >> 23) & 0xff) -
+                                  126);
+    return fromBits((bits & 0x807fffffu) | 0x3f000000u);
+  }
+
+private:
+  static uint32_t toBits(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+  }
+  static float fromBits(uint32_t bits) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+  }
+};
+
+//==============================================================================
+// Scalar entry points, for code that processes one sample at a time.
+using ScalarFunction = float (*)(float);
+
+template <Tier T> float scalarTanh(float x) {
+  if constexpr (T == Tier::Exact)
+    return std::tanh(x);
+  else
+    return tanh(Vec<ScalarOps, T>{x}).v;
+}
+
+// std::tanh for Exact, the approximation otherwise
+inline ScalarFunction getTanhFunction(Tier tier) {
+  switch (tier) {
+  case Tier::High:
+    return &scalarTanh<Tier::High>;
+  case Tier::Eco:
+    return &scalarTanh<Tier::Eco>;
+  case Tier::Exact:
+    break;
+  }
+  return &scalarTanh<Tier::Exact>;
+}
+
+} // namespace FastMath
@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+    FastMathVec.h
+    -------------
+    The vector half of FastMath.h: Vec<Ops, Tier> and the approximations,
+    written against the Ops interface only.
+
+    Role:
+    SimdWaveshapers_AVX2.cpp and SimdWaveshapers_AVX512.cpp are compiled
+    with extra ISA flags. Any inline function they emit with external
+    linkage (from JUCE or the standard library) could be the copy the
+    linker keeps for the whole plugin, and crash with an illegal
+    instruction on CPUs without those sets. So this header, like
+    SimdWaveshaperKernels.h, includes nothing: every function here is a
+    template over Vec<Ops, Tier>, and those TUs instantiate it with Ops
+    types of their own (internal linkage) only. Keep it free of JUCE and
+    std:: code.
+
+    See FastMath.h for the tiers, their error bounds and the Ops interface.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace FastMath {
+
+enum class Tier { Exact, High, Eco };
+constexpr int numTiers = 3;
+
+constexpr float pi = 3.14159265358979323846f;
+constexpr float twoPi = 6.28318530717958647692f;
+
+//==============================================================================
+// Thin value wrapper so the math (and the waveshapes) can be written with
+// plain operators. The tier travels with the type.
+template <typename OpsType, Tier T = Tier::Exact> struct Vec {
+  using Ops = OpsType;
+  using Reg = typename Ops::Reg;
+  using Mask = typename Ops::Mask;
+  static constexpr Tier tier = T;
+
+  Reg v;
+
+  static Vec of(float x) { return {Ops::broadcast(x)}; }
+
+  friend Vec operator+(Vec a, Vec b) { return {Ops::add(a.v, b.v)}; }
+  friend Vec operator-(Vec a, Vec b) { return {Ops::sub(a.v, b.v)}; }
+  friend Vec operator*(Vec a, Vec b) { return {Ops::mul(a.v, b.v)}; }
+  friend Vec operator/(Vec a, Vec b) { return {Ops::div(a.v, b.v)}; }
+  friend Vec operator-(Vec a) {
+    return {Ops::xorBits(a.v, Ops::broadcast(-0.0f))};
+  }
+
+  friend Vec operator+(Vec a, float b) { return a + of(b); }
+  friend Vec operator-(Vec a, float b) { return a - of(b); }
+  friend Vec operator*(Vec a, float b) { return a * of(b); }
+  friend Vec operator/(Vec a, float b) { return a / of(b); }
+  friend Vec operator+(float a, Vec b) { return of(a) + b; }
+  friend Vec operator-(float a, Vec b) { return of(a) - b; }
+  friend Vec operator*(float a, Vec b) { return of(a) * b; }
+  friend Vec operator/(float a, Vec b) { return of(a) / b; }
+
+  friend Mask operator>(Vec a, Vec b) { return Ops::cmpGt(a.v, b.v); }
+  friend Mask operator<(Vec a, Vec b) { return Ops::cmpLt(a.v, b.v); }
+  friend Mask operator>(Vec a, float b) { return a > of(b); }
+  friend Mask operator<(Vec a, float b) { return a < of(b); }
+};
+
+//==============================================================================
+// Helpers
+template <typename F> F select(typename F::Mask m, F a, F b) {
+  return {F::Ops::select(m, a.v, b.v)};
+}
+template <typename F> F select(typename F::Mask m, float a, F b) {
+  return select(m, F::of(a), b);
+}
+template <typename F> F select(typename F::Mask m, F a, float b) {
+  return select(m, a, F::of(b));
+}
+
+template <typename F> F abs(F x) { return {F::Ops::abs(x.v)}; }
+template <typename F> F sqrt(F x) { return {F::Ops::sqrt(x.v)}; }
+template <typename F> F min(F a, F b) { return {F::Ops::min(a.v, b.v)}; }
+template <typename F> F max(F a, F b) { return {F::Ops::max(a.v, b.v)}; }
+template <typename F> F min(F a, float b) { return min(a, F::of(b)); }
+template <typename F> F max(F a, float b) { return max(a, F::of(b)); }
+template <typename F> F clamp(F x, float lo, float hi) {
+  return min(max(x, lo), hi);
+}
+template <typename F> F mulAdd(F a, F b, float c) {
+  return {F::Ops::mulAdd(a.v, b.v, F::Ops::broadcast(c))};
+}
+template <typename F> F roundNearest(F x) {
+  return {F::Ops::roundNearest(x.v)};
+}
+
+// x > 0 ? 1 : -1 (same convention as the scalar curves)
+template <typename F> F sign(F x) {
+  return select(x > 0.0f, 1.0f, F::of(-1.0f));
+}
+
+// |mag| with the sign of signSource
+template <typename F> F copySign(F mag, F signSource) {
+  return {F::Ops::orBits(F::Ops::abs(mag.v), F::Ops::signBits(signSource.v))};
+}
+
+// floor() for values that fit in an int
+template <typename F> F floor(F x) {
+  F r = roundNearest(x);
+  return r - select(r > x, 1.0f, F::of(0.0f));
+}
+
+//==============================================================================
+// exp: 2^n * p(r) with r = x - n * ln2, |r| <= ln2 / 2
+template <typename F> F exp(F x) {
+  x = clamp(x, -87.0f, 88.0f);
+  const F n = roundNearest(x * 1.44269504088896341f);
+  F r = x - n * 0.693359375f;
+  r = r - n * -2.12194440e-4f;
+
+  F y;
+  if constexpr (F::tier == Tier::Exact) {
+    // Cephes expf
+    F p = F::of(1.9875691500e-4f);
+    p = mulAdd(p, r, 1.3981999507e-3f);
+    p = mulAdd(p, r, 8.3334519073e-3f);
+    p = mulAdd(p, r, 4.1665795894e-2f);
+    p = mulAdd(p, r, 1.6666665459e-1f);
+    p = mulAdd(p, r, 5.0000001201e-1f);
+    y = p * (r * r) + r + 1.0f;
+  } else if constexpr (F::tier == Tier::High) {
+    y = F::of(4.14586179e-2f);
+    y = mulAdd(y, r, 1.67909086e-1f);
+    y = mulAdd(y, r, 5.00043571e-1f);
+    y = mulAdd(y, r, 9.99963403e-1f);
+    y = mulAdd(y, r, 9.99999285e-1f);
+  } else {
+    y = F::of(1.65668488e-1f);
+    y = mulAdd(y, r, 5.04963398e-1f);
+    y = mulAdd(y, r, 1.00016415f);
+    y = mulAdd(y, r, 9.99928057e-1f);
+  }
+  return y * F{F::Ops::exp2Int(n.v)};
+}
+
+// tanh: 1 - 2 / (e^2|x| + 1) with the sign of x. The Exact tier switches to
+// Cephes' odd polynomial near zero to keep the relative error small there.
+template <typename F> F tanh(F x) {
+  const F ax = abs(x);
+  const F e = exp(min(ax, 9.0f) * 2.0f);
+  const F large = copySign(1.0f - 2.0f / (e + 1.0f), x);
+
+  if constexpr (F::tier == Tier::Exact) {
+    const F z = x * x;
+    F p = F::of(-5.70498872745e-3f);
+    p = mulAdd(p, z, 2.06390887954e-2f);
+    p = mulAdd(p, z, -5.37397155531e-2f);
+    p = mulAdd(p, z, 1.33314422036e-1f);
+    p = mulAdd(p, z, -3.33332819422e-1f);
+    const F small = x + x * z * p;
+    return select(ax < 0.625f, small, large);
+  } else {
+    return large;
+  }
+}
+
+// atan: Cephes range reduction (Exact) or one reflection around 1 followed
+// by an odd minimax polynomial on [0, 1] (High, Eco)
+template <typename F> F atan(F x) {
+  const F ax = abs(x);
+
+  if constexpr (F::tier == Tier::Exact) {
+    const auto big = ax > 2.414213562373095f;
+    const auto mid = ax > 0.4142135623730950f;
+
+    F y = select(big, pi * 0.5f, select(mid, F::of(pi * 0.25f), F::of(0.0f)));
+    const F xr =
+        select(big, -1.0f / ax, select(mid, (ax - 1.0f) / (ax + 1.0f), ax));
+
+    const F z = xr * xr;
+    F p = F::of(8.05374449538e-2f);
+    p = mulAdd(p, z, -1.38776856032e-1f);
+    p = mulAdd(p, z, 1.99777106478e-1f);
+    p = mulAdd(p, z, -3.33329491539e-1f);
+    y = y + p * z * xr + xr;
+    return copySign(y, x);
+  } else {
+    const auto inverted = ax > 1.0f;
+    const F t = select(inverted, 1.0f / ax, ax);
+    const F z = t * t;
+    F p;
+    if constexpr (F::tier == Tier::High) {
+      p = F::of(2.08450332e-2f);
+      p = mulAdd(p, z, -8.51561949e-2f);
+      p = mulAdd(p, z, 1.80159196e-1f);
+      p = mulAdd(p, z, -3.30304772e-1f);
+      p = mulAdd(p, z, 9.99866307e-1f);
+    } else {
+      p = F::of(7.93386027e-2f);
+      p = mulAdd(p, z, -2.88689822e-1f);
+      p = mulAdd(p, z, 9.95357871e-1f);
+    }
+    const F y = p * t;
+    return copySign(select(inverted, pi * 0.5f - y, y), x);
+  }
+}
+
+// sin: reduction to [-pi/2, pi/2] followed by an odd polynomial (Taylor to
+// x^11 for Exact, minimax for High and Eco)
+template <typename F> F sin(F x) {
+  const F k = roundNearest(x * (1.0f / twoPi));
+  F r = x - k * 6.28125f;
+  r = r - k * 1.9353071795864769e-3f;
+  r = select(r > pi * 0.5f, pi - r, select(r < -pi * 0.5f, -pi - r, r));
+
+  const F z = r * r;
+  F p;
+  if constexpr (F::tier == Tier::Exact) {
+    p = F::of(-2.5052108385e-8f);
+    p = mulAdd(p, z, 2.7557319224e-6f);
+    p = mulAdd(p, z, -1.9841269841e-4f);
+    p = mulAdd(p, z, 8.3333333333e-3f);
+    p = mulAdd(p, z, -1.6666666667e-1f);
+    p = mulAdd(p, z, 1.0f);
+  } else if constexpr (F::tier == Tier::High) {
+    p = F::of(-1.83636483e-4f);
+    p = mulAdd(p, z, 8.30632541e-3f);
+    p = mulAdd(p, z, -1.66648284e-1f);
+    p = mulAdd(p, z, 9.99996603e-1f);
+  } else {
+    p = F::of(7.51437200e-3f);
+    p = mulAdd(p, z, -1.65673062e-1f);
+    p = mulAdd(p, z, 9.99696791e-1f);
+  }
+  return p * r;
+}
+
+// log (x > 0): exponent * ln2 + log(1 + m) with m in [sqrt(0.5) - 1,
+// sqrt(2) - 1]
+template <typename F> F log(F x) {
+  typename F::Reg exponent;
+  F m{F::Ops::frexp(x.v, exponent)};
+  F e{exponent};
+
+  const auto lt = m < 0.707106781186547524f;
+  e = select(lt, e - 1.0f, e);
+  m = select(lt, m + m - 1.0f, m - 1.0f);
+
+  if constexpr (F::tier == Tier::Exact) {
+    // Cephes logf
+    const F z = m * m;
+    F y = F::of(7.0376836292e-2f);
+    y = mulAdd(y, m, -1.1514610310e-1f);
+    y = mulAdd(y, m, 1.1676998740e-1f);
+    y = mulAdd(y, m, -1.2420140846e-1f);
+    y = mulAdd(y, m, 1.4249322787e-1f);
+    y = mulAdd(y, m, -1.6668057665e-1f);
+    y = mulAdd(y, m, 2.0000714765e-1f);
+    y = mulAdd(y, m, -2.4999993993e-1f);
+    y = mulAdd(y, m, 3.3333331174e-1f);
+    y = y * m * z;
+    y = y + e * -2.12194440e-4f;
+    y = y - z * 0.5f;
+    return m + y + e * 0.693359375f;
+  } else {
+    F p;
+    if constexpr (F::tier == Tier::High) {
+      p = F::of(1.75130904e-1f);
+      p = mulAdd(p, m, -2.73499101e-1f);
+      p = mulAdd(p, m, 3.37345183e-1f);
+      p = mulAdd(p, m, -4.99233544e-1f);
+      p = mulAdd(p, m, 9.99918878e-1f);
+    } else {
+      p = F::of(3.08499455e-1f);
+      p = mulAdd(p, m, -5.22690000e-1f);
+      p = mulAdd(p, m, 1.00170314f);
+    }
+    return p * m + e * 0.693147180559945f;
+  }
+}
+
+// pow for x > 0
+template <typename F> F pow(F x, F y) { return exp(y * log(x)); }
+
+template <typename F> F sinh(F x) {
+  const F e = exp(x);
+  return (e - 1.0f / e) * 0.5f;
+}
+
+template <typename F> F cosh(F x) {
+  const F e = exp(x);
+  return (e + 1.0f / e) * 0.5f;
+}
+
+} // namespace FastMath
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    -------------------
+    Per-block copy of the plugin parameters.
+
+    Role:
+    apvts.getRawParameterValue("id") looks the parameter up by its string
+    ID. With ~20 parameters per block and hundreds of instances those
+    lookups show up in profiles, so the processor resolves every ID once
+    (attach(), in its constructor) and then reads the raw values through
+    the cached std::atomic<float> pointers once per block (update()).
+
+    update() also records which values moved since the previous block, so
+    the processor only recomputes what depends on them (gains in dB, the
+    mix fraction, ...).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+namespace Params {
+
+// Every parameter read by the audio thread. The order only matters for
+// ids below.
+enum Id : int {
+  bypass,
+  drive,
+  shape,
+  waveshape,
+  lowEnable,
+  lowFreq,
+  lowWarmth,
+  lowLevel,
+  highEnable,
+  highFreq,
+  highSoftness,
+  highLevel,
+  inputGain,
+  mix,
+  output,
+  prePost,
+  limiter,
+  delta,
+  deltaGain,
+  quality,
+  shaperMode,
+  oversampling,
+  offlineOversampling,
+  oversamplingFilter,
+  automationResolution,
+  governor,
+  cpuBudget,
+  numIds
+};
+
+// Parameter IDs, as in createParameterLayout()
+constexpr const char *ids[numIds] = {
+    "bypass",       "drive",        "shape",        "waveshape",
+    "lowEnable",    "lowFreq",      "lowWarmth",    "lowLevel",
+    "highEnable",   "highFreq",     "highSoftness", "highLevel",
+    "inputGain",    "mix",          "output",       "prePost",
+    "limiter",      "delta",        "deltaGain",    "quality",
+    "shaperMode",   "oversampling", "offlineOversampling",
+    "oversamplingFilter", "automationResolution", "governor",
+    "cpuBudget"};
+
+} // namespace Params
+
+class ParameterSnapshot {
+public:
+  // Message thread, once: resolves every ID
+  void attach(juce::AudioProcessorValueTreeState &apvts) {
+    for (int i = 0; i < Params::numIds; ++i) {
+      handles[(size_t)i] = apvts.getRawParameterValue(Params::ids[i]);
+      jassert(handles[(size_t)i] != nullptr); // unknown parameter ID
+    }
+  }
+
+  // The live value, for code that runs outside of processBlock()
+  float load(Params::Id id) const { return handles[(size_t)id]->load(); }
+
+  //==============================================================================
+  // Audio thread
+
+  // Copies every value and sets the change flags against the previous copy
+  void update() {
+    changedFlags = forceChanged ? ~juce::uint32() : 0;
+    forceChanged = false;
+    for (int i = 0; i < Params::numIds; ++i) {
+      const float value = handles[(size_t)i]->load(std::memory_order_relaxed);
+      if (value != values[(size_t)i]) {
+        values[(size_t)i] = value;
+        changedFlags |= juce::uint32(1) << i;
+      }
+    }
+  }
+
+  // Flags every value as changed on the next update() (after
+  // prepareToPlay(), when everything derived must be recomputed)
+  void invalidate() { forceChanged = true; }
+
+  float get(Params::Id id) const { return values[(size_t)id]; }
+  bool getBool(Params::Id id) const { return values[(size_t)id] >= 0.5f; }
+  int getInt(Params::Id id) const { return (int)values[(size_t)id]; }
+
+  // True if any of the given values changed in the last update()
+  template <typename... Ids> bool changed(Ids... idsToCheck) const {
+    return (((changedFlags >> (int)idsToCheck) & 1u) | ...) != 0;
+  }
+  bool anyChanged() const { return changedFlags != 0; }
+
+private:
+  static_assert(Params::numIds <= 32, "the change flags are a 32-bit mask");
+
+  std::array<std::atomic<float> *, Params::numIds> handles{};
+  std::array<float, Params::numIds> values{};
+  juce::uint32 changedFlags = 0;
+  bool forceChanged = true;
+};
@@ -96,6 +96,16 @@ DevToolsPopover::DevToolsPopover(CustomLookAndFeel &laf) : lookAndFeel(laf) {
   viewport.getVerticalScrollBar().setColour(juce::ScrollBar::thumbColourId,
       juce::Colour::fromFloatRGBA(0.5f, 0.3f, 0.15f, 0.6f));
   addAndMakeVisible(viewport);
+
+  traceButton.setClickingTogglesState(true);
+  traceButton.setTooltip("Records a timeline of the audio thread, the "
+                         "visualizer timer and the editor paint (Chrome "
+                         "trace JSON, in Documents)");
+  traceButton.onClick = [this]() {
+    if (onTraceToggled)
+      onTraceToggled(traceButton.getToggleState());
+  };
+  addAndMakeVisible(traceButton);
 }
 
 void DevToolsPopover::setMetrics(const DevToolsMetrics &newMetrics) {
@@ -108,10 +118,31 @@ void DevToolsPopover::setMetrics(const DevToolsMetrics &newMetrics) {
   leftCol.add(juce::String::formatted("Rate: %.0f Hz", metrics.sampleRate));
   leftCol.add(juce::String::formatted("Buffer: %d", metrics.blockSize));
   leftCol.add(juce::String::formatted("Latency: %d", metrics.latencySamples));
+  leftCol.add(juce::String::formatted("OS: %dx", metrics.oversamplingFactor) +
+              (metrics.oversamplingAuto ? " (Auto)" : ""));
   leftCol.add(juce::String::formatted("I/O: %d/%d", metrics.inputChannels,
                                        metrics.outputChannels));
   leftCol.add(juce::String::formatted("Params: %d", metrics.parameterCount));
   leftCol.add(juce::String::formatted("RMS: %.3f", metrics.currentRms));
+  leftCol.add("SIMD: " + metrics.simdIsa);
+  leftCol.add("Dual mono: " + juce::String(metrics.dualMonoBlocks) +
+              " blocks");
+  leftCol.add("Suspended: " + juce::String(metrics.suspendedBlocks) +
+              " blocks");
+  leftCol.add(juce::String::formatted("Governor: level %d",
+                                       metrics.governorLevel));
+  leftCol.add("Stages (avg / p99 us):");
+  for (const auto &stage : metrics.stageTimings)
+    leftCol.add(stage.name + juce::String::formatted(
+                                 ": %.1f / %.1f", stage.averageMicroseconds,
+                                 stage.p99Microseconds));
+  leftCol.add(juce::String::formatted("Deadline p50/p90/p99: %.0f/%.0f/%.0f%%",
+                                       metrics.deadlineP50, metrics.deadlineP90,
+                                       metrics.deadlineP99));
+  leftCol.add(juce::String::formatted("Deadline max: %.0f%% (%d samples)",
+                                       metrics.deadlineMax,
+                                       metrics.worstBlockSamples));
+  leftCol.add("Overruns: " + juce::String(metrics.overruns) + " blocks");
 
   // Right column - UI info
   rightCol.add(juce::String::formatted("UI: %.1f fps", metrics.uiFps));
@@ -121,6 +152,18 @@ void DevToolsPopover::setMetrics(const DevToolsMetrics &newMetrics) {
   rightCol.add("Tab: " + metrics.activeTabLabel);
   rightCol.add(juce::String("Viz: ") + (metrics.visualizersActive ? "On" : "Off"));
   rightCol.add("Build: " + metrics.buildHash);
+  if (metrics.tracing)
+    rightCol.add("Trace: recording (" + juce::String(metrics.traceDropped) +
+                 " dropped)");
+  else
+    rightCol.add("Trace: " + (metrics.traceFileName.isEmpty()
+                                  ? juce::String("off")
+                                  : metrics.traceFileName));
+  traceButton.setToggleState(metrics.tracing, juce::dontSendNotification);
+  if (metrics.worstBlockSamples > 0) {
+    rightCol.add("Slowest block with:");
+    rightCol.addArray(metrics.worstBlockParameters);
+  }
 
   content.setLines(leftCol, rightCol);
 }
@@ -132,7 +175,8 @@ void DevToolsPopover::resized() {
 
   // Viewport area (with padding for title)
   auto viewportArea = body.reduced(10, 8);
-  viewportArea.removeFromTop(20); // Space for title
+  auto titleRow = viewportArea.removeFromTop(20); // Space for title
+  traceButton.setBounds(titleRow.removeFromRight(60).reduced(0, 1));
   viewport.setBounds(viewportArea);
   content.setSize(viewportArea.getWidth() - 10, content.getRequiredHeight());
 }
@@ -188,7 +232,7 @@ Vst_saturatorAudioProcessorEditor::Vst_saturatorAudioProcessorEditor(
     Vst_saturatorAudioProcessor &p)
     : AudioProcessorEditor(&p), audioProcessor(p),
       tabLookAndFeel(customLookAndFeel),
-      visualizerTab(p.analyzerTap, p.apvts.state),
+      visualizerTab(p.analyzerTap, p.apvts.state, p.traceRecorder),
       tooltipWindow(this, 1500, customLookAndFeel),
       devToolsPopover(customLookAndFeel) {
 
@@ -702,6 +746,7 @@ CPU, FPS, buffers, état des visualizers.)"));
   devToolsButton.onClick = [this]() {
     devToolsOpen = devToolsButton.getToggleState();
     devToolsPopover.setVisible(devToolsOpen);
+    audioProcessor.setStageTimingEnabled(devToolsOpen);
     if (devToolsOpen) {
       devToolsPopover.toFront(false);
       refreshDevTools();
@@ -711,6 +756,19 @@ CPU, FPS, buffers, état des visualizers.)"));
     }
   };
   addAndMakeVisible(devToolsButton);
+  devToolsPopover.onTraceToggled = [this](bool shouldTrace) {
+    auto &traceRecorder = audioProcessor.traceRecorder;
+    if (shouldTrace)
+      traceRecorder.start(
+          juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+              .getChildFile("Steverator Trace " +
+                            juce::Time::getCurrentTime().formatted(
+                                "%Y-%m-%d %H-%M-%S") +
+                            ".json"));
+    else
+      traceRecorder.stop();
+    refreshDevTools(); // the button follows isRecording()
+  };
   devToolsPopover.setVisible(false);
   addAndMakeVisible(devToolsPopover);
 
@@ -748,6 +806,7 @@ CPU, FPS, buffers, état des visualizers.)"));
 
 Vst_saturatorAudioProcessorEditor::~Vst_saturatorAudioProcessorEditor() {
   stopTimer();
+  audioProcessor.setStageTimingEnabled(false);
 }
 
 //==============================================================================
@@ -835,6 +894,8 @@ void Vst_saturatorAudioProcessorEditor::refreshDevTools() {
   metrics.sampleRate = audioProcessor.getSampleRate();
   metrics.blockSize = audioProcessor.getBlockSize();
   metrics.latencySamples = audioProcessor.getLatencySamples();
+  metrics.oversamplingFactor = audioProcessor.getOversamplingFactor();
+  metrics.oversamplingAuto = audioProcessor.isOversamplingAuto();
   metrics.inputChannels = audioProcessor.getTotalNumInputChannels();
   metrics.outputChannels = audioProcessor.getTotalNumOutputChannels();
   metrics.parameterCount =
@@ -860,6 +921,42 @@ void Vst_saturatorAudioProcessorEditor::refreshDevTools() {
       audioProcessor.currentRMSLevel.load(std::memory_order_relaxed);
   metrics.windowSize =
       juce::String(getWidth()) + "x" + juce::String(getHeight());
+  metrics.simdIsa =
+      juce::String(audioProcessor.getWaveshaperIsaName()) + " " +
+      audioProcessor.apvts.getParameter("quality")->getCurrentValueAsText();
+  metrics.dualMonoBlocks = audioProcessor.getNumDualMonoBlocks();
+  metrics.suspendedBlocks = audioProcessor.getNumSuspendedBlocks();
+  metrics.governorLevel = audioProcessor.getGovernorLevel();
+  for (int stage = 0; stage < StageTimings::numStages; ++stage) {
+    const auto timing = audioProcessor.getStageTiming(stage);
+    metrics.stageTimings.push_back({StageTimings::getName(stage),
+                                    timing.getAverage() * 0.001,
+                                    timing.getPercentile(0.99) * 0.001});
+  }
+
+  // Loads are in parts per million of the deadline
+  const auto &deadlines = audioProcessor.getDeadlineMonitor();
+  const auto loads = deadlines.getLoads();
+  metrics.deadlineP50 = loads.getPercentile(0.5) * 1.0e-4;
+  metrics.deadlineP90 = loads.getPercentile(0.9) * 1.0e-4;
+  metrics.deadlineP99 = loads.getPercentile(0.99) * 1.0e-4;
+  metrics.overruns = deadlines.getNumOverruns();
+  const auto &traceRecorder = audioProcessor.traceRecorder;
+  metrics.tracing = traceRecorder.isRecording();
+  metrics.traceFileName = traceRecorder.getFile().getFileName();
+  metrics.traceDropped = traceRecorder.getNumDropped();
+  const auto worst = deadlines.getWorstBlock();
+  metrics.deadlineMax = worst.load * 100.0;
+  metrics.worstBlockSamples = worst.numSamples;
+  for (int i = 0; i < Params::numIds; ++i) {
+    auto *parameter = audioProcessor.apvts.getParameter(Params::ids[i]);
+    const float value = parameter->convertTo0to1(worst.parameters[(size_t)i]);
+    if (std::abs(value - parameter->getDefaultValue()) > 1.0e-4f)
+      metrics.worstBlockParameters.add(
+          (parameter->getName(32) + ": " + parameter->getText(value, 32) +
+           " " + parameter->getLabel())
+              .trimEnd());
+  }
 
   devToolsPopover.setMetrics(metrics);
 }
@@ -878,6 +975,9 @@ Vst_saturatorAudioProcessorEditor::scaleDesignBounds(int x, int y, int width,
 
 //==============================================================================
 void Vst_saturatorAudioProcessorEditor::paint(juce::Graphics &g) {
+  const TraceRecorder::Scope trace(audioProcessor.traceRecorder,
+                                   TraceRecorder::paintTrack,
+                                   TraceRecorder::editorPaint);
   const auto nowMs = juce::Time::getMillisecondCounterHiRes();
   if (lastUiPaintMs > 0.0) {
     const auto deltaMs = nowMs - lastUiPaintMs;
@@ -1286,313 +1386,16 @@ void Vst_saturatorAudioProcessorEditor::resized() {
 //==============================================================================
 
 void Vst_saturatorAudioProcessorEditor::initializePresets() {
-  // Clear any existing presets
-  presets.clear();
-
-  // ============ CLASSICS (1-6) ============
-  presets.push_back({"Warm Tape", 16, 6.0f, 0.4f, 0.0f, 75.0f, 0.0f, true,
-                     120.0f, 0.5f, 2.0f, true, 4000.0f, 0.6f, 1.0f, true,
-                     false});
-  presets.push_back({"Tube Glow", 1, 8.0f, 0.3f, 0.0f, 80.0f, -1.0f, true,
-                     100.0f, 0.6f, 3.0f, true, 6000.0f, 0.4f, 2.0f, true,
-                     false});
-  presets.push_back({"Soft Clip", 2, 5.0f, 0.5f, 0.0f, 70.0f, 0.0f, false,
-                     80.0f, 0.3f, 0.0f, false, 3000.0f, 0.5f, 0.0f, false,
-                     false});
-  presets.push_back({"Vintage Console", 1, 4.0f, 0.2f, 2.0f, 60.0f, -2.0f, true,
-                     150.0f, 0.4f, 1.5f, true, 8000.0f, 0.7f, 1.0f, true,
-                     true});
-  presets.push_back({"Analog Warmth", 18, 3.0f, 0.3f, 0.0f, 50.0f, 0.0f, true,
-                     100.0f, 0.5f, 2.0f, true, 5000.0f, 0.5f, 1.5f, false,
-                     false});
-  presets.push_back({"Classic Overdrive", 17, 10.0f, 0.4f, 0.0f, 85.0f, -2.0f,
-                     true, 80.0f, 0.3f, 1.0f, true, 4500.0f, 0.3f, 1.5f, true,
-                     false});
-
-  // ============ MUSIC STYLES (7-12) ============
-  presets.push_back({"Hip-Hop Low End", 1, 7.0f, 0.2f, 3.0f, 65.0f, 0.0f, true,
-                     200.0f, 0.8f, 4.0f, false, 2000.0f, 0.5f, 0.0f, true,
-                     false});
-  presets.push_back({"EDM Punch", 3, 12.0f, 0.6f, 2.0f, 90.0f, -3.0f, true,
-                     100.0f, 0.4f, 3.0f, true, 6000.0f, 0.2f, 2.5f, true,
-                     true});
-  presets.push_back({"Rock Crunch", 17, 14.0f, 0.5f, 0.0f, 100.0f, -4.0f, true,
-                     150.0f, 0.3f, 2.0f, true, 5000.0f, 0.3f, 2.0f, true,
-                     false});
-  presets.push_back({"Jazz Warmth", 1, 3.0f, 0.2f, 0.0f, 40.0f, 0.0f, true,
-                     80.0f, 0.6f, 1.5f, true, 7000.0f, 0.8f, 0.5f, false,
-                     false});
-  presets.push_back({"Lo-Fi Beats", 9, 8.0f, 0.7f, -2.0f, 70.0f, 0.0f, true,
-                     300.0f, 0.6f, 2.0f, true, 3000.0f, 0.9f, -1.0f, false,
-                     true});
-  presets.push_back({"Metal Aggression", 3, 20.0f, 0.8f, 4.0f, 100.0f, -6.0f,
-                     true, 120.0f, 0.2f, 3.0f, true, 4000.0f, 0.1f, 3.5f, true,
-                     true});
-
-  // ============ INSTRUMENTS (13-20) ============
-  presets.push_back({"Bass Growl", 4, 9.0f, 0.4f, 2.0f, 80.0f, -1.0f, true,
-                     250.0f, 0.7f, 4.0f, false, 1500.0f, 0.6f, 0.0f, true,
-                     false});
-  presets.push_back({"Vocal Warmth", 18, 4.0f, 0.3f, 0.0f, 45.0f, 1.0f, false,
-                     100.0f, 0.4f, 0.0f, true, 8000.0f, 0.7f, 1.0f, false,
-                     true});
-  presets.push_back({"Drums Punch", 2, 8.0f, 0.5f, 3.0f, 75.0f, -2.0f, true,
-                     80.0f, 0.3f, 2.5f, true, 6000.0f, 0.4f, 2.0f, true, true});
-  presets.push_back({"Guitar Amp", 15, 11.0f, 0.6f, 0.0f, 90.0f, -3.0f, true,
-                     100.0f, 0.4f, 1.5f, true, 5000.0f, 0.3f, 2.5f, true,
-                     false});
-  presets.push_back({"Synth Edge", 12, 7.0f, 0.7f, 1.0f, 70.0f, 0.0f, true,
-                     60.0f, 0.2f, 1.0f, true, 7000.0f, 0.3f, 3.0f, false,
-                     true});
-  presets.push_back({"Piano Glue", 1, 2.5f, 0.2f, 0.0f, 35.0f, 0.0f, true,
-                     100.0f, 0.4f, 1.0f, true, 6000.0f, 0.6f, 0.5f, false,
-                     false});
-  presets.push_back({"Strings Silk", 16, 3.0f, 0.3f, 0.0f, 40.0f, 0.5f, false,
-                     150.0f, 0.5f, 0.0f, true, 8000.0f, 0.8f, 1.0f, false,
-                     false});
-  presets.push_back({"Horns Presence", 1, 5.0f, 0.4f, 1.0f, 55.0f, 0.0f, true,
-                     200.0f, 0.3f, 1.5f, true, 5000.0f, 0.4f, 2.0f, false,
-                     true});
-
-  // ============ CREATIVE / FX (21-26) ============
-  presets.push_back({"Bitcrushed", 9, 15.0f, 0.9f, 0.0f, 80.0f, -4.0f, false,
-                     100.0f, 0.5f, 0.0f, false, 4000.0f, 0.5f, 0.0f, true,
-                     true});
-  presets.push_back({"Fuzz Box", 4, 18.0f, 0.7f, 3.0f, 95.0f, -5.0f, true,
-                     80.0f, 0.5f, 2.0f, true, 3500.0f, 0.2f, 2.5f, true,
-                     false});
-  presets.push_back({"Wave Folder", 6, 10.0f, 0.6f, 0.0f, 85.0f, -3.0f, true,
-                     100.0f, 0.3f, 1.0f, true, 5000.0f, 0.4f, 1.5f, true,
-                     true});
-  presets.push_back({"Sin Fold", 7, 12.0f, 0.8f, 0.0f, 75.0f, -4.0f, true,
-                     120.0f, 0.4f, 1.5f, true, 6000.0f, 0.3f, 2.0f, true,
-                     false});
-  presets.push_back({"Rectifier", 11, 8.0f, 0.5f, 0.0f, 70.0f, -2.0f, true,
-                     100.0f, 0.4f, 2.0f, true, 4500.0f, 0.5f, 1.5f, true,
-                     true});
-  presets.push_back({"Extreme Destroy", 3, 24.0f, 1.0f, 6.0f, 100.0f, -8.0f,
-                     true, 50.0f, 0.2f, 4.0f, true, 3000.0f, 0.1f, 4.0f, true,
-                     true});
-
-  // ============ NEW CREATIVE (27-36) ============
-  presets.push_back({"Digital Grit", 18, 12.0f, 0.8f, 0.0f, 80.0f, -2.0f, true,
-                     100.0f, 0.3f, 1.0f, true, 5000.0f, 0.2f, 2.0f, true,
-                     false});
-  presets.push_back({"Glitchy Bass", 19, 9.0f, 0.4f, 2.0f, 85.0f, -1.0f, true,
-                     150.0f, 0.7f, 3.0f, true, 3000.0f, 0.5f, 0.5f, false,
-                     true});
-  presets.push_back({"Valve Master", 20, 4.5f, 0.3f, 0.0f, 40.0f, 0.0f, true,
-                     80.0f, 0.4f, 1.0f, true, 6000.0f, 0.8f, 0.5f, false,
-                     false});
-  presets.push_back({"Hard Fuzz", 21, 15.0f, 0.6f, 3.0f, 95.0f, -4.0f, true,
-                     200.0f, 0.2f, 2.0f, true, 4000.0f, 0.1f, 3.0f, true,
-                     true});
-  presets.push_back({"Harmonic Filter", 22, 7.0f, 0.5f, 0.0f, 60.0f, 0.0f, true,
-                     120.0f, 0.1f, 1.5f, true, 5500.0f, 0.4f, 2.0f, false,
-                     false});
-  presets.push_back({"Polished Sat.", 26, 6.0f, 0.2f, 0.0f, 50.0f, 0.0f, true,
-                     90.0f, 0.5f, 1.0f, true, 7500.0f, 0.7f, 0.5f, false,
-                     false});
-  presets.push_back({"Log Deep", 24, 10.0f, 0.4f, 1.0f, 70.0f, -2.0f, true,
-                     60.0f, 0.8f, 3.5f, false, 8000.0f, 0.5f, 0.0f, true,
-                     false});
-  presets.push_back({"Half Vintage", 25, 8.0f, 0.3f, 0.0f, 45.0f, 0.0f, true,
-                     110.0f, 0.4f, 1.5f, true, 4500.0f, 0.6f, 1.2f, false,
-                     true});
-  presets.push_back({"Octave Dirt", 27, 14.0f, 0.6f, 2.0f, 80.0f, -3.0f, true,
-                     70.0f, 0.3f, 2.0f, true, 5000.0f, 0.2f, 2.5f, true, true});
-  presets.push_back({"Pentode Drive", 20, 11.0f, 0.7f, 1.0f, 90.0f, -3.0f, true,
-                     150.0f, 0.4f, 2.5f, true, 4000.0f, 0.3f, 2.0f, true,
-                     false});
-
-  // ============ MASTERING / SUBTLE (37-40) ============
-  presets.push_back({"Master Glue", 18, 2.0f, 0.15f, 0.0f, 25.0f, 0.0f, true,
-                     80.0f, 0.4f, 0.5f, true, 10000.0f, 0.7f, 0.5f, true,
-                     false});
-  presets.push_back({"Parallel Crush", 2, 12.0f, 0.5f, 0.0f, 30.0f, 0.0f, true,
-                     100.0f, 0.5f, 2.0f, true, 5000.0f, 0.4f, 1.5f, true,
-                     true});
-  presets.push_back({"Subtle Harmonics", 1, 1.5f, 0.1f, 0.0f, 20.0f, 0.5f, true,
-                     100.0f, 0.3f, 0.5f, true, 8000.0f, 0.6f, 0.5f, false,
-                     false});
-  presets.push_back({"Bus Warmth", 16, 4.0f, 0.25f, 0.0f, 40.0f, -0.5f, true,
-                     120.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
-                     false});
-
-  // ============ NEW: DECAPITATOR STYLE (41-48) ============
-  presets.push_back({"Punish (A)", 28, 16.0f, 0.7f, 4.0f, 100.0f, -5.0f, true,
-                     100.0f, 0.3f, 2.5f, true, 4000.0f, 0.2f, 3.0f, true,
-                     true}); // Triode aggressive
-  presets.push_back({"Pentode Power", 29, 12.0f, 0.5f, 2.0f, 85.0f, -3.0f, true,
-                     150.0f, 0.4f, 2.0f, true, 5000.0f, 0.3f, 2.5f, true,
-                     false}); // Pentode classic
-  presets.push_back({"Class A Warmth", 30, 6.0f, 0.3f, 0.0f, 60.0f, 0.0f, true,
-                     80.0f, 0.6f, 1.5f, true, 8000.0f, 0.7f, 1.0f, false,
-                     false}); // Single-ended smooth
-  presets.push_back({"Push-Pull Punch", 31, 10.0f, 0.5f, 3.0f, 80.0f, -2.0f,
-                     true, 120.0f, 0.3f, 2.5f, true, 5500.0f, 0.4f, 2.0f, true,
-                     true}); // Class AB power
-  presets.push_back({"Germanium Fuzz", 33, 14.0f, 0.6f, 2.0f, 90.0f, -4.0f,
-                     true, 200.0f, 0.2f, 3.0f, true, 3500.0f, 0.15f, 3.5f, true,
-                     false}); // Vintage fuzz
-  presets.push_back({"Triode Clean", 28, 3.0f, 0.2f, 0.0f, 35.0f, 0.5f, true,
-                     100.0f, 0.4f, 1.0f, true, 9000.0f, 0.8f, 0.5f, false,
-                     false}); // Subtle tube
-  presets.push_back({"Hot Pentode", 29, 18.0f, 0.8f, 5.0f, 95.0f, -6.0f, true,
-                     80.0f, 0.2f, 3.5f, true, 4000.0f, 0.1f, 4.0f, true,
-                     true}); // Pushed hard
-  presets.push_back({"Class B Grit", 32, 8.0f, 0.4f, 0.0f, 70.0f, -1.0f, true,
-                     100.0f, 0.3f, 1.5f, true, 6000.0f, 0.5f, 1.5f, true,
-                     false}); // Crossover character
-
-  // ============ NEW: SATURN TAPE STYLE (49-56) ============
-  presets.push_back({"Tape Machine 15", 34, 5.0f, 0.3f, 0.0f, 55.0f, 0.0f, true,
-                     100.0f, 0.5f, 1.0f, true, 12000.0f, 0.6f, 0.5f, false,
-                     false}); // Fast bright tape
-  presets.push_back({"Tape Machine 7.5", 35, 7.0f, 0.4f, 0.0f, 65.0f, 0.0f,
-                     true, 80.0f, 0.7f, 2.0f, true, 6000.0f, 0.8f, 1.0f, false,
-                     false}); // Slow warm tape
-  presets.push_back({"Lo-Fi Cassette", 36, 10.0f, 0.6f, -1.0f, 75.0f, 0.0f,
-                     true, 250.0f, 0.5f, 2.5f, true, 4000.0f, 0.9f, -1.0f,
-                     false, true}); // Cassette vibes
-  presets.push_back({"Ampex 456", 37, 8.0f, 0.5f, 2.0f, 70.0f, -1.0f, true,
-                     150.0f, 0.6f, 3.0f, true, 7000.0f, 0.5f, 1.5f, true,
-                     false}); // Punchy 456
-  presets.push_back({"Modern Tape", 38, 4.0f, 0.25f, 0.0f, 45.0f, 0.0f, true,
-                     100.0f, 0.4f, 1.0f, true, 10000.0f, 0.7f, 0.5f, false,
-                     false}); // SM900 clean
-  presets.push_back({"Tape Slam", 37, 15.0f, 0.7f, 4.0f, 90.0f, -4.0f, true,
-                     80.0f, 0.4f, 3.5f, true, 5000.0f, 0.3f, 3.0f, true,
-                     true}); // Driven tape
-  presets.push_back({"Tape + Tube", 34, 6.0f, 0.4f, 1.0f, 60.0f, 0.0f, true,
-                     120.0f, 0.5f, 2.0f, true, 8000.0f, 0.6f, 1.5f, false,
-                     true}); // Combined flavor
-  presets.push_back({"Vintage Deck", 35, 9.0f, 0.5f, 0.0f, 70.0f, -1.0f, true,
-                     100.0f, 0.6f, 2.5f, true, 5000.0f, 0.7f, 1.0f, true,
-                     false}); // Reel-to-reel
-
-  // ============ NEW: CONSOLE / TRANSFORMER (57-62) ============
-  presets.push_back({"Neve Console", 40, 5.0f, 0.3f, 1.0f, 50.0f, 0.0f, true,
-                     100.0f, 0.5f, 1.5f, true, 8000.0f, 0.6f, 1.0f, false,
-                     false}); // Neve warmth
-  presets.push_back({"API Punch", 41, 8.0f, 0.5f, 2.0f, 70.0f, -1.0f, true,
-                     150.0f, 0.4f, 2.5f, true, 6000.0f, 0.4f, 2.0f, true,
-                     true}); // API character
-  presets.push_back({"SSL Sheen", 42, 4.0f, 0.25f, 0.0f, 40.0f, 0.5f, true,
-                     80.0f, 0.3f, 1.0f, true, 12000.0f, 0.5f, 0.5f, false,
-                     false}); // SSL clean
-  presets.push_back({"Iron Saturator", 39, 7.0f, 0.4f, 0.0f, 60.0f, 0.0f, true,
-                     100.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
-                     false}); // Transformer sat
-  presets.push_back({"Console Crunch", 40, 12.0f, 0.6f, 3.0f, 85.0f, -3.0f,
-                     true, 120.0f, 0.3f, 2.5f, true, 5000.0f, 0.3f, 2.5f, true,
-                     true}); // Pushed console
-  presets.push_back({"Vintage Desk", 39, 6.0f, 0.35f, 1.0f, 55.0f, 0.0f, true,
-                     100.0f, 0.6f, 2.0f, true, 6000.0f, 0.7f, 1.5f, false,
-                     false}); // Old school
-
-  // ============ NEW: MODERN PRODUCTION (63-68) ============
-  presets.push_back({"FET Vocal", 44, 4.0f, 0.3f, 0.0f, 45.0f, 0.0f, false,
-                     80.0f, 0.4f, 0.0f, true, 10000.0f, 0.6f, 0.5f, true,
-                     true}); // 1176 vocal
-  presets.push_back({"All Buttons In", 45, 12.0f, 0.7f, 3.0f, 80.0f, -3.0f,
-                     true, 100.0f, 0.3f, 2.0f, true, 5000.0f, 0.3f, 2.5f, true,
-                     true}); // 1176 slammed
-  presets.push_back({"Silicon Bass", 43, 9.0f, 0.4f, 3.0f, 75.0f, -1.0f, true,
-                     250.0f, 0.7f, 4.0f, false, 2000.0f, 0.5f, 0.0f, true,
-                     false}); // Transistor bass
-  presets.push_back({"OpAmp Drive", 46, 10.0f, 0.5f, 2.0f, 80.0f, -2.0f, true,
-                     100.0f, 0.4f, 2.0f, true, 6000.0f, 0.4f, 2.0f, true,
-                     true}); // IC character
-  presets.push_back({"Digital Hybrid", 47, 6.0f, 0.5f, 0.0f, 60.0f, 0.0f, true,
-                     80.0f, 0.3f, 1.0f, true, 8000.0f, 0.5f, 1.5f, false,
-                     false}); // CMOS blend
-  presets.push_back({"Parallel FET", 44, 8.0f, 0.4f, 0.0f, 35.0f, 0.0f, true,
-                     100.0f, 0.5f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
-                     true}); // Parallel compression
-
-  // ============ NEW: CREATIVE / SOUND DESIGN (69-76) ============
-  presets.push_back({"Screamer", 48, 16.0f, 0.8f, 4.0f, 95.0f, -5.0f, true,
-                     100.0f, 0.2f, 3.0f, true, 4000.0f, 0.1f, 3.5f, true,
-                     true}); // Aggressive scream
-  presets.push_back({"Buzz Saw", 49, 14.0f, 0.7f, 2.0f, 85.0f, -4.0f, true,
-                     80.0f, 0.3f, 2.0f, true, 5000.0f, 0.2f, 3.0f, true,
-                     false}); // Buzzy character
-  presets.push_back({"Vinyl Crackle", 50, 5.0f, 0.6f, -2.0f, 50.0f, 0.0f, true,
-                     200.0f, 0.4f, 1.0f, true, 4000.0f, 0.8f, -0.5f, false,
-                     false}); // Crackle texture
-  presets.push_back({"Wrap Around", 51, 10.0f, 0.5f, 0.0f, 75.0f, -2.0f, true,
-                     100.0f, 0.4f, 1.5f, true, 6000.0f, 0.4f, 2.0f, true,
-                     true}); // Wrap distortion
-  presets.push_back({"Dense Stack", 52, 8.0f, 0.4f, 2.0f, 70.0f, -1.0f, true,
-                     150.0f, 0.5f, 2.5f, true, 5500.0f, 0.5f, 2.0f, true,
-                     false}); // Thick density
-  presets.push_back({"Harmonic 7", 53, 6.0f, 0.5f, 0.0f, 55.0f, 0.0f, true,
-                     100.0f, 0.3f, 1.0f, true, 8000.0f, 0.5f, 1.0f, false,
-                     false}); // Chebyshev 7
-  presets.push_back({"Hyperbolic", 54, 7.0f, 0.4f, 0.0f, 60.0f, 0.0f, true,
-                     80.0f, 0.4f, 1.5f, true, 7000.0f, 0.6f, 1.0f, true,
-                     false}); // Sinh character
-  presets.push_back({"Wavelet FX", 57, 8.0f, 0.6f, 0.0f, 65.0f, -1.0f, true,
-                     100.0f, 0.5f, 1.5f, true, 6000.0f, 0.5f, 1.5f, true,
-                     true}); // Wavelet texture
-
-  for (auto &preset : presets) {
-    preset.limiter = false;
-  }
+  // The table lives in FactoryPresets.cpp (shared with steverator_render)
+  presets = FactoryPresets::create();
 }
 
 void Vst_saturatorAudioProcessorEditor::applyPreset(int presetIndex) {
   if (presetIndex < 0 || presetIndex >= static_cast<int>(presets.size()))
     return;
 
-  const auto &p = presets[static_cast<size_t>(presetIndex)];
-
-  // Apply all parameter values using the APVTS
-  auto &apvts = audioProcessor.apvts;
-
-  // Waveshape (ComboBox - 1-indexed)
-  if (auto *param = apvts.getParameter("waveshape"))
-    param->setValueNotifyingHost(
-        param->convertTo0to1(static_cast<float>(p.waveshape)));
-
-  // Global controls
-  if (auto *param = apvts.getParameter("drive"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.drive));
-  if (auto *param = apvts.getParameter("shape"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.shape));
-  if (auto *param = apvts.getParameter("inputGain"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.inputGain));
-  if (auto *param = apvts.getParameter("mix"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.mix));
-  if (auto *param = apvts.getParameter("output"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.outputGain));
-
-  // Low band
-  if (auto *param = apvts.getParameter("lowEnable"))
-    param->setValueNotifyingHost(p.lowEnable ? 1.0f : 0.0f);
-  if (auto *param = apvts.getParameter("lowFreq"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.lowFreq));
-  if (auto *param = apvts.getParameter("lowWarmth"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.lowWarmth));
-  if (auto *param = apvts.getParameter("lowLevel"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.lowLevel));
-
-  // High band
-  if (auto *param = apvts.getParameter("highEnable"))
-    param->setValueNotifyingHost(p.highEnable ? 1.0f : 0.0f);
-  if (auto *param = apvts.getParameter("highFreq"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.highFreq));
-  if (auto *param = apvts.getParameter("highSoftness"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.highSoftness));
-  if (auto *param = apvts.getParameter("highLevel"))
-    param->setValueNotifyingHost(param->convertTo0to1(p.highLevel));
-
-  // Routing
-  if (auto *param = apvts.getParameter("limiter"))
-    param->setValueNotifyingHost(p.limiter ? 1.0f : 0.0f);
-  if (auto *param = apvts.getParameter("prePost"))
-    param->setValueNotifyingHost(p.prePost ? 1.0f : 0.0f);
+  FactoryPresets::apply(audioProcessor.apvts,
+                        presets[static_cast<size_t>(presetIndex)]);
 }
 
 void Vst_saturatorAudioProcessorEditor::navigatePreset(int direction) {
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "CustomLookAndFeel.h"
+#include "FactoryPresets.h"
 #include "PluginProcessor.h"
 #include "VisualizerComponents.h"
 #include <JuceHeader.h>
@@ -63,6 +64,8 @@ struct DevToolsMetrics {
   double sampleRate = 0.0;
   int blockSize = 0;
   int latencySamples = 0;
+  int oversamplingFactor = 1;
+  bool oversamplingAuto = false;
   int inputChannels = 0;
   int outputChannels = 0;
   int parameterCount = 0;
@@ -77,6 +80,30 @@ struct DevToolsMetrics {
   bool visualizersActive = false;
   float currentRms = 0.0f;
   juce::String windowSize;
+  juce::String simdIsa;
+  juce::int64 dualMonoBlocks = 0;
+  juce::int64 suspendedBlocks = 0;
+  int governorLevel = 0;
+
+  // Per-stage time per chunk (StageTimings.h)
+  struct StageTiming {
+    juce::String name;
+    double averageMicroseconds = 0.0;
+    double p99Microseconds = 0.0;
+  };
+  std::vector<StageTiming> stageTimings;
+
+  // Block time as a percentage of its deadline (DeadlineMonitor.h)
+  double deadlineP50 = 0.0, deadlineP90 = 0.0, deadlineP99 = 0.0;
+  double deadlineMax = 0.0;
+  juce::int64 overruns = 0;
+  int worstBlockSamples = 0;
+  juce::StringArray worstBlockParameters; // the ones not at their default
+
+  // Trace recorder (TraceRecorder.h)
+  bool tracing = false;
+  juce::String traceFileName;
+  juce::int64 traceDropped = 0;
 };
 
 // Internal content component for DevTools (scrollable)
@@ -99,11 +126,15 @@ public:
   void paint(juce::Graphics &g) override;
   void resized() override;
 
+  // Called when the Trace button is toggled (true = start recording)
+  std::function<void(bool)> onTraceToggled;
+
 private:
   CustomLookAndFeel &lookAndFeel;
   DevToolsMetrics metrics;
   DevToolsContent content;
   juce::Viewport viewport;
+  juce::TextButton traceButton{"Trace"};
 };
 
 class Vst_saturatorAudioProcessorEditor : public juce::AudioProcessorEditor,
@@ -210,28 +241,8 @@ private:
   juce::TextButton waveLeftBtn{"<"};
   juce::TextButton waveRightBtn{">"};
 
-  // Preset data structure
-  struct PresetData {
-    juce::String name;
-    int waveshape;    // 1-18
-    float drive;      // 0-24
-    float shape;      // 0-1
-    float inputGain;  // -24 to +24
-    float mix;        // 0-100
-    float outputGain; // -24 to +24
-    bool lowEnable;
-    float lowFreq;   // 20-500
-    float lowWarmth; // 0-1
-    float lowLevel;  // 0-12
-    bool highEnable;
-    float highFreq;     // 500-16000
-    float highSoftness; // 0-1
-    float highLevel;    // 0-12
-    bool limiter;
-    bool prePost;
-  };
-
-  std::vector<PresetData> presets;
+  // Factory presets (FactoryPresets.h)
+  std::vector<FactoryPresets::Preset> presets;
   void initializePresets();
   void applyPreset(int presetIndex);
   void navigatePreset(int direction);    // -1 for prev, +1 for next
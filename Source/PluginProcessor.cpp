@@ -10,7 +10,9 @@
 */
 
 #include "PluginProcessor.h"
+#if !STEVERATOR_HEADLESS
 #include "PluginEditor.h"
+#endif
 
 //==============================================================================
 // Constructor
@@ -27,17 +29,14 @@ Vst_saturatorAudioProcessor::Vst_saturatorAudioProcessor()
 #endif
               ),
       // Initialize APVTS with specific parameters
-      apvts(*this, nullptr, "Parameters", createParameterLayout()),
-      // Initialize Oversampling with 2 channels, 4x factor, and high-quality
-      // filter
-      oversampling(2, 2,
-                   juce::dsp::Oversampling<
-                       float>::FilterType::filterHalfBandPolyphaseIIR)
+      apvts(*this, nullptr, "Parameters", createParameterLayout())
 #endif
 {
+  parameters.attach(apvts);
+  startTimerHz(30); // picks up the oversampling requests (timerCallback())
 }
 
-Vst_saturatorAudioProcessor::~Vst_saturatorAudioProcessor() {}
+Vst_saturatorAudioProcessor::~Vst_saturatorAudioProcessor() { stopTimer(); }
 
 //==============================================================================
 // Parameter Layout
@@ -185,9 +184,167 @@ Vst_saturatorAudioProcessor::createParameterLayout() {
       "deltaGain", "Delta Gain", -24.0f, 0.0f,
       -12.0f)); // Delta gain in dB (default: -12 dB for safety)
 
+  // F. Engine (CPU vs accuracy trade-offs)
+  // Accuracy tier of the math in the waveshapers, the high band softness and
+  // the delta safety clipper (see FastMath.h for the error of each tier)
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "quality", "Quality", juce::StringArray{"Exact", "High", "Eco"}, 0));
+  // Direct evaluates the curve for every sample, Table uses an interpolated
+  // lookup table rebuilt in the background (same cost for every waveshape),
+  // ADAA adds antiderivative anti-aliasing so a lower oversampling factor
+  // can be used (see Adaa.h)
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "shaperMode", "Shaper Mode",
+      juce::StringArray{"Direct", "Table", "ADAA"}, 0));
+  // Oversampling factor of the saturation stage (default 4x; "Auto" picks
+  // it from the sample rate and the waveshape), and a separate factor for
+  // offline renders ("Same" = use the realtime one), so tracking stays
+  // cheap while bounces get the best quality
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "oversampling", "Oversampling",
+      juce::StringArray{"1x", "2x", "4x", "8x", "16x", "Auto"}, 2));
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "offlineOversampling", "Offline Oversampling",
+      juce::StringArray{"Same", "1x", "2x", "4x", "8x", "16x"}, 0));
+  // Oversampling filters: minimum-phase IIR (lowest latency) or linear-phase
+  // FIR (no phase distortion, more latency). The dry path is delayed to match.
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "oversamplingFilter", "Oversampling Filter",
+      juce::StringArray{"IIR", "Linear Phase"}, 0));
+  // How often processBlock() reads the parameters: once per block, or every
+  // 16 to 128 samples (sub-blocks), for finer automation
+  layout.add(std::make_unique<juce::AudioParameterChoice>(
+      "automationResolution", "Automation Resolution",
+      juce::StringArray{"Block", "16", "32", "64", "128"}, 0));
+  // CPU governor: lowers the quality step by step while the processing
+  // takes more than "CPU Budget" percent of the real time (see
+  // updateGovernor())
+  layout.add(std::make_unique<juce::AudioParameterBool>(
+      "governor", "CPU Governor", false));
+  layout.add(std::make_unique<juce::AudioParameterFloat>(
+      "cpuBudget", "CPU Budget", 5.0f, 100.0f, 50.0f));
+
   return layout;
 }
 
+//==============================================================================
+void Vst_saturatorAudioProcessor::updateDerivedParameters() {
+  const auto &p = parameters;
+  if (p.changed(Params::drive))
+    derived.drive = juce::Decibels::decibelsToGain(p.get(Params::drive));
+  if (p.changed(Params::inputGain))
+    derived.inputGain =
+        juce::Decibels::decibelsToGain(p.get(Params::inputGain));
+  if (p.changed(Params::output))
+    derived.outputGain = juce::Decibels::decibelsToGain(p.get(Params::output));
+  if (p.changed(Params::lowLevel))
+    derived.lowLevel = juce::Decibels::decibelsToGain(p.get(Params::lowLevel));
+  if (p.changed(Params::highLevel))
+    derived.highLevel =
+        juce::Decibels::decibelsToGain(p.get(Params::highLevel));
+  if (p.changed(Params::mix))
+    derived.mix = p.get(Params::mix) / 100.0f;
+  if (p.changed(Params::deltaGain))
+    derived.deltaGain =
+        juce::Decibels::decibelsToGain(p.get(Params::deltaGain));
+
+  ramps[driveRamp].setTarget(derived.drive);
+  ramps[inputGainRamp].setTarget(derived.inputGain);
+  ramps[outputGainRamp].setTarget(derived.outputGain);
+  ramps[lowLevelRamp].setTarget(derived.lowLevel);
+  ramps[highLevelRamp].setTarget(derived.highLevel);
+  ramps[mixRamp].setTarget(derived.mix);
+  ramps[deltaGainRamp].setTarget(derived.deltaGain);
+}
+
+int Vst_saturatorAudioProcessor::getWantedOversampling(bool governed) const {
+  // Live values: this also runs on the message thread
+  const int realtime = (int)parameters.load(Params::oversampling);
+  const int offline = (int)parameters.load(Params::offlineOversampling);
+  const int filter = (int)parameters.load(Params::oversamplingFilter);
+  int stages = isNonRealtime() && offline > 0 ? offline - 1 : realtime;
+  if (stages == autoOversampling)
+    stages = getAutoOversamplingStages();
+  if (governed && governorLevel.load(std::memory_order_relaxed) >= 1)
+    stages = juce::jmax(0, stages - 1);
+  return filter * numOversamplingFactors + stages;
+}
+
+bool Vst_saturatorAudioProcessor::isOversamplingAuto() const {
+  const bool offline = isNonRealtime() &&
+                       (int)parameters.load(Params::offlineOversampling) > 0;
+  return !offline &&
+         (int)parameters.load(Params::oversampling) == autoOversampling;
+}
+
+int Vst_saturatorAudioProcessor::getAutoOversamplingStages() const {
+  const double sampleRate = getSampleRate();
+  if (sampleRate <= 0.0)
+    return 2; // 4x, the default
+
+  // Wideband curves need twice the rate; ADAA needs half (see Adaa.h)
+  double target = autoOversampledRate;
+  if (Waveshapers::isWideband((int)parameters.load(Params::waveshape)))
+    target *= 2.0;
+  if ((int)parameters.load(Params::shaperMode) == 2)
+    target *= 0.5;
+
+  // The smallest factor reaching the target (44.1 kHz x 4 counts as
+  // 176 kHz)
+  int stages = 0;
+  while (stages < numOversamplingFactors - 1 &&
+         sampleRate * (1 << stages) < target)
+    ++stages;
+  return stages;
+}
+
+Vst_saturatorAudioProcessor::Oversampler &
+Vst_saturatorAudioProcessor::getOversampler(int index) {
+  auto &oversampler = oversamplers[(size_t)index];
+  if (oversampler == nullptr) {
+    using FilterType = juce::dsp::Oversampling<float>::FilterType;
+    oversampler = std::make_unique<Oversampler>(
+        index % numOversamplingFactors,
+        index < numOversamplingFactors
+            ? FilterType::filterHalfBandPolyphaseIIR
+            : FilterType::filterHalfBandFIREquiripple);
+    oversampler->initProcessing((size_t)preparedBlockSize);
+  }
+  return *oversampler;
+}
+
+void Vst_saturatorAudioProcessor::updateOversampling() {
+  const int wanted = getWantedOversampling();
+  const int reference = getWantedOversampling(false);
+  if (preparedBlockSize == 0 || (wanted == preparedOversampling.load() &&
+                                 reference == referenceOversampling.load()))
+    return;
+
+  auto &oversampler = getOversampler(wanted);
+  const int latency =
+      juce::roundToInt(getOversampler(reference).getLatencyInSamples());
+
+  // Start from silence, unless the audio thread may already be running
+  // this one: it is published, or still active (switching back before the
+  // previous change was picked up)
+  if (wanted != preparedOversampling.load() &&
+      wanted != activeOversampling.load())
+    oversampler.reset();
+
+  referenceOversampling.store(reference);
+  preparedLatency.store(latency);
+  preparedOversampling.store(wanted, std::memory_order_release);
+  setLatencySamples(latency);
+}
+
+void Vst_saturatorAudioProcessor::timerCallback() {
+  const int requested = requestedOversampling.load();
+  if (requested >= 0 && (requested != preparedOversampling.load() ||
+                         requestedReference.load() !=
+                             referenceOversampling.load()))
+    updateOversampling();
+}
+
 //==============================================================================
 // 1. Preparation
 const juce::String Vst_saturatorAudioProcessor::getName() const {
@@ -218,7 +375,24 @@ bool Vst_saturatorAudioProcessor::isMidiEffect() const {
 #endif
 }
 
-double Vst_saturatorAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+double Vst_saturatorAudioProcessor::getTailLengthSeconds() const {
+  const double sampleRate = getSampleRate();
+  if (sampleRate <= 0.0)
+    return 0.0;
+
+  // Oversampling filters: their latency, and as long again to ring out
+  const double oversamplingTail = 2.0 * getLatencySamples() / sampleRate;
+
+  // Crossover: the slowest poles are those of the Butterworth sections at
+  // the lowest Low Freq (damping 1/sqrt(2)). Each decays to silenceThreshold
+  // in ln(1 / silenceThreshold) / (2 pi f / sqrt(2)); two are cascaded.
+  const double crossoverTail =
+      2.0 * std::log(1.0 / silenceThreshold) /
+      (juce::MathConstants<double>::twoPi * minLowFrequency /
+       juce::MathConstants<double>::sqrt2);
+
+  return oversamplingTail + crossoverTail + limiterReleaseMs * 0.001;
+}
 
 int Vst_saturatorAudioProcessor::getNumPrograms() {
   return 1; // NB: some hosts don't cope very well if you tell them there are 0
@@ -249,39 +423,92 @@ void Vst_saturatorAudioProcessor::prepareToPlay(double sampleRate,
   // 1. Prepare DSP Spec
   juce::dsp::ProcessSpec spec{sampleRate, (juce::uint32)samplesPerBlock,
                               (juce::uint32)getTotalNumOutputChannels()};
-  lastSampleRate = sampleRate;
-
-  // 2. Initialize and Reset Crossover Filters
-  lp1.prepare(spec);
-  hp1.prepare(spec);
-  lp2.prepare(spec);
-  hp2.prepare(spec);
-  lp1.reset();
-  hp1.reset();
-  lp2.reset();
-  hp2.reset();
+
+  // 2. Initialize and Reset the Crossover
+  crossover.prepare(sampleRate);
 
   // 3. Initialize and Reset Limiter
   limiter.prepare(spec);
+  limiter.setRelease((float)limiterReleaseMs);
   limiter.reset();
 
-  // 4. Resize internal buffers
-  lowBuffer.setSize(spec.numChannels, spec.maximumBlockSize);
-  midBuffer.setSize(spec.numChannels, spec.maximumBlockSize);
-  highBuffer.setSize(spec.numChannels, spec.maximumBlockSize);
-
-  // 6. Prepare Oversampling
-  oversampling.initProcessing(spec.maximumBlockSize);
-
-  // 7. Force filter coefficient update
-  lastLowFreq = 0.0f;
-  lastHighFreq = 0.0f;
-
-  // 8. Delta monitoring crossfade: ~10ms fade time for anti-click
+  // 4. Resize internal buffers. processBlock() only ever shrinks them
+  // (without reallocating), so they must hold every channel of the host
+  // buffer.
+  const int numBufferChannels =
+      juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels());
+  dryBuffer.setSize(numBufferChannels, samplesPerBlock);
+
+  // 6. Prepare Oversampling: resize the oversamplers created so far, then
+  // create the wanted factor (realtime or offline) if needed. The
+  // lookup-table crossfade runs at the oversampled rate.
+  preparedBlockSize = (int)spec.maximumBlockSize;
+  for (auto &oversampler : oversamplers) {
+    if (oversampler != nullptr) {
+      oversampler->initProcessing(spec.maximumBlockSize);
+      oversampler->reset();
+    }
+  }
+  // Full quality (the governor starts over)
+  governorLevel = 0;
+  pendingGovernorLevel = 0;
+  governorOverSeconds = governorUnderSeconds = 0.0;
+  preparedOversampling = -1;
+  referenceOversampling = -1;
+  activeOversampling = -1;
+  requestedOversampling = -1;
+  updateOversampling();
+  activeOversampling = preparedOversampling.load();
+  latencyInUse = preparedLatency.load();
+  waveshaperTable.prepare(sampleRate * getOversamplingFactor());
+  adaaStates = {};
+
+  // Dry delay line matching the reported latency, and the wet padding
+  // (none at full quality)
+  dryDelayLine.setSize(numBufferChannels, maxDryDelay);
+  dryDelayLine.clear();
+  dryDelayWritePosition = 0;
+  dryDelaySamples = juce::jlimit(0, maxDryDelay - 1, latencyInUse);
+  previousDryDelaySamples = dryDelaySamples;
+  wetDelayLine.setSize(numBufferChannels, maxDryDelay);
+  wetDelayLine.clear();
+  wetDelayWritePosition = 0;
+  wetDelaySamples = 0;
+  dryDelayFade = 1.0f;
+  oversamplingSettleSamples = 0;
+
+  // 7. Force derived parameter updates; the gain ramps start at their
+  // targets (snapCrossfades)
+  parameters.invalidate();
+  for (auto &ramp : ramps)
+    ramp.prepare(sampleRate, samplesPerBlock);
+  driveRampBuffer.setSize(1, samplesPerBlock
+                                 << (numOversamplingFactors - 1));
+
+  // 8. Routing crossfades (delta, limiter, Pre/Post): ~10ms fade time for
+  // anti-click
   // Calculate step per sample: 1.0 / (fadeTimeSeconds * sampleRate)
   const float fadeTimeMs = 10.0f;
-  deltaCrossfadeStep =
+  routingCrossfadeStep =
       1.0f / (fadeTimeMs * 0.001f * static_cast<float>(sampleRate));
+  limiterBuffer.setSize(numBufferChannels, samplesPerBlock);
+  snapCrossfades = true;
+  bypassSmoothed = parameters.load(Params::bypass) >= 0.5f ? 1.0f : 0.0f;
+  bypassStale = false;
+  bypassHoldSamples = 0;
+
+  // 9. Silence detection, dual mono detection and the stage timings start
+  // over
+  stageTimings.reset();
+  deadlineMonitor.reset();
+  suspended = false;
+  silentInputSamples = 0;
+  dualMono = false;
+  identicalInputSamples = 0;
+  saturationHistory.setSize(1, saturationHistoryLength);
+  saturationHistory.clear();
+  saturationHistoryPosition = 0;
+  replayBuffer.setSize(1, samplesPerBlock);
 
   analyzerTap.prepare(sampleRate);
 }
@@ -310,6 +537,8 @@ void Vst_saturatorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                                juce::MidiBuffer &midiMessages) {
   // CPU usage timing start
   const auto cpuTimerStart = juce::Time::getHighResolutionTicks();
+  const TraceRecorder::Scope trace(traceRecorder, TraceRecorder::audioTrack,
+                                   TraceRecorder::processBlock);
 
   juce::ignoreUnused(midiMessages);
   juce::ScopedNoDenormals noDenormals;
@@ -321,566 +550,441 @@ void Vst_saturatorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
 
   // 1. Get Parameter Values
   // Global
-  bool bypass = *apvts.getRawParameterValue("bypass");
-  if (bypass)
+  parameters.update();
+  updateDerivedParameters();
+  if (preparedBlockSize == 0)
     return;
 
-  float saturation = *apvts.getRawParameterValue("drive");
-  float shape = *apvts.getRawParameterValue("shape");
+  // Silence detection (see suspended)
+  const int numSamples = buffer.getNumSamples();
+  bool silentInput = true;
+  for (int channel = 0; channel < totalNumInputChannels && silentInput;
+       ++channel)
+    silentInput = buffer.getMagnitude(channel, 0, numSamples) <=
+                  (float)silenceThreshold;
+  silentInputSamples = silentInput ? silentInputSamples + numSamples : 0;
+  if (suspended && (!silentInput || parameters.anyChanged()))
+    wakeUp();
+
+  if (suspended) {
+    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+      juce::FloatVectorOperations::fill(buffer.getWritePointer(channel),
+                                        heldOutput[(size_t)channel],
+                                        numSamples);
+    analyzerTap.pushSamples(buffer, buffer);
+    numSuspendedBlocks.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    // Hosts may send more samples than prepareToPlay() announced. Those
+    // blocks are processed in chunks of the prepared size, so that no
+    // buffer ever has to grow on the audio thread. With an "Automation
+    // Resolution" the chunks are shorter (16 to 128 samples) and the
+    // parameters are read again before each one; the chunks reuse the
+    // same buffers and DSP state.
+    const int resolution = parameters.getInt(Params::automationResolution);
+    const int chunkSize =
+        resolution > 0 ? juce::jmin(preparedBlockSize, 8 << resolution)
+                       : preparedBlockSize;
+    for (int start = 0; start < numSamples; start += chunkSize) {
+      if (start > 0 && resolution > 0) {
+        parameters.update();
+        updateDerivedParameters();
+      }
+      juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(),
+                                     buffer.getNumChannels(), start,
+                                     juce::jmin(chunkSize,
+                                                numSamples - start));
+      processChunk(chunk);
+    }
+    if (dualMono)
+      numDualMonoBlocks.fetch_add(1, std::memory_order_relaxed);
+  }
 
-  // Low Band
-  bool lowEnable = *apvts.getRawParameterValue("lowEnable");
-  float lowFreq = *apvts.getRawParameterValue("lowFreq");
-  float lowWarmth = *apvts.getRawParameterValue("lowWarmth");
-  float lowLevel = juce::Decibels::decibelsToGain(
-      apvts.getRawParameterValue("lowLevel")->load());
+  // === ENVELOPE FOLLOWER UPDATE ===
+  // Calculate max peak of the output block to drive UI
+  float maxPeak = 0.0f;
+  {
+    const StageTimings::Scope timing(stageTimings, StageTimings::envelope);
+    for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
+      maxPeak = juce::jmax(
+          maxPeak, buffer.getMagnitude(channel, 0, buffer.getNumSamples()));
+    }
+  }
 
-  // High Band
-  bool highEnable = *apvts.getRawParameterValue("highEnable");
-  float highFreq = *apvts.getRawParameterValue("highFreq");
-  float highSoftness = *apvts.getRawParameterValue("highSoftness");
-  float highLevel = juce::Decibels::decibelsToGain(
-      apvts.getRawParameterValue("highLevel")->load());
+  // Suspend once the input has been silent for the whole tail and the
+  // output has settled to a constant (silence, or the DC offset of curves
+  // such as Wavelet), which is then held
+  if (!suspended && numSamples > 0 &&
+      silentInputSamples >= getTailLengthSeconds() * getSampleRate()) {
+    bool settled = totalNumOutputChannels <= (int)heldOutput.size();
+    for (int channel = 0; channel < totalNumOutputChannels && settled;
+         ++channel)
+      settled = buffer.findMinMax(channel, 0, numSamples).getLength() <=
+                (float)silenceThreshold;
+    if (settled) {
+      for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+        heldOutput[(size_t)channel] = buffer.getSample(channel, numSamples - 1);
+      suspended = true;
+    }
+  }
 
-  // Gain & Routing
-  float inputGain = juce::Decibels::decibelsToGain(
-      apvts.getRawParameterValue("inputGain")->load());
-  float mix = *apvts.getRawParameterValue("mix") / 100.0f;
-  float outputGain = juce::Decibels::decibelsToGain(
-      apvts.getRawParameterValue("output")->load());
-  bool prePost = *apvts.getRawParameterValue("prePost");
-  bool limiterEnable = *apvts.getRawParameterValue("limiter");
+  // Simple smoothing/decay could be done here, or just push peak to UI
+  // Pushing current peak is fine for "Is Talking" logic
+  // We use atomic store
+  currentRMSLevel.store(maxPeak, std::memory_order_relaxed);
 
-  // Delta Monitoring
-  bool deltaEnabled = *apvts.getRawParameterValue("delta");
-  float deltaGainDb = *apvts.getRawParameterValue("deltaGain");
-  float deltaGain = juce::Decibels::decibelsToGain(deltaGainDb);
+  // CPU usage timing end
+  const auto cpuTimerEnd = juce::Time::getHighResolutionTicks();
+  const double elapsedSec = juce::Time::highResolutionTicksToSeconds(cpuTimerEnd - cpuTimerStart);
+  const double bufferDuration = static_cast<double>(buffer.getNumSamples()) / getSampleRate();
+  if (bufferDuration > 0.0) {
+    // Smooth the CPU reading (exponential moving average)
+    const double newCpu = elapsedSec / bufferDuration;
+    const double smoothing = 0.1; // lower = smoother
+    cpuUsage.store(cpuUsage.load(std::memory_order_relaxed) * (1.0 - smoothing) + newCpu * smoothing,
+                   std::memory_order_relaxed);
+    updateGovernor(cpuUsage.load(std::memory_order_relaxed), bufferDuration);
+    deadlineMonitor.addBlock(elapsedSec, bufferDuration,
+                             buffer.getNumSamples(), parameters);
+  }
+}
 
-  // Update delta crossfade state (smooth transitions to avoid clicks)
-  float targetDeltaSmoothed = deltaEnabled ? 1.0f : 0.0f;
-  // We'll update deltaSmoothed per-sample in the final stage
+template <size_t... indices>
+constexpr std::array<Vst_saturatorAudioProcessor::Pipeline, sizeof...(indices)>
+Vst_saturatorAudioProcessor::makePipelines(std::index_sequence<indices...>) {
+  // index = post * 18 + delta * 6 + limiter * 2 + mixed, as in processChunk()
+  return {&Vst_saturatorAudioProcessor::runPipeline<
+      (indices / 18) != 0, static_cast<StageState>(indices / 6 % 3),
+      static_cast<StageState>(indices / 2 % 3), (indices % 2) != 0>...};
+}
 
-  // 2. Gain Staging
-  // Store a clean copy of the input signal for the Dry/Wet mix.
-  juce::AudioBuffer<float> dryBuffer;
-  dryBuffer.makeCopyOf(buffer);
+// Everything from the parameter reads to the analyzer, for at most
+// preparedBlockSize samples.
+void Vst_saturatorAudioProcessor::processChunk(
+    juce::AudioBuffer<float> &buffer) {
+  const TraceRecorder::Scope trace(traceRecorder, TraceRecorder::audioTrack,
+                                   TraceRecorder::processChunk);
+
+  // Parameters (read once per block in processBlock())
+  const auto &p = parameters;
+  ChunkContext context;
+  context.shape = p.get(Params::shape);
+
+  // Low and High Bands (3-band split, band stages and sum in one pass, see
+  // Crossover.h)
+  auto &bands = context.bands;
+  bands.lowEnable = p.getBool(Params::lowEnable);
+  bands.lowWarmth = p.get(Params::lowWarmth);
+  bands.highEnable = p.getBool(Params::highEnable);
+  bands.highSoftness = p.get(Params::highSoftness);
 
-  // Apply Input Gain
-  buffer.applyGain(inputGain);
+  // Gain & Routing
+  const bool prePost = p.getBool(Params::prePost);
+  const bool limiterEnable = p.getBool(Params::limiter);
 
-  // 3. Update Filter Coefficients (if needed)
-  if (lowFreq != lastLowFreq || getSampleRate() != lastSampleRate) {
-    lp1.setCutoffFrequency(lowFreq);
-    hp1.setCutoffFrequency(lowFreq);
-    lastLowFreq = lowFreq;
-  }
-  if (highFreq != lastHighFreq || getSampleRate() != lastSampleRate) {
-    lp2.setCutoffFrequency(highFreq);
-    hp2.setCutoffFrequency(highFreq);
-    lastHighFreq = highFreq;
+  // Delta Monitoring
+  const bool deltaEnabled = p.getBool(Params::delta);
+
+  // Engine, lowered by the CPU governor: level 2 takes the next tier, level
+  // 3 the lookup table for Direct waveshapes
+  const int governor = governorLevel.load(std::memory_order_relaxed);
+  const auto quality = static_cast<FastMath::Tier>(juce::jmin(
+      FastMath::numTiers - 1, p.getInt(Params::quality) + (governor >= 2)));
+  context.tanh = FastMath::getTanhFunction(quality);
+  bands.tanh = context.tanh;
+  const int shaperMode = p.getInt(Params::shaperMode);
+  const bool tableMode = shaperMode == 1 || (shaperMode == 0 && governor >= 3);
+  context.adaaMode = shaperMode == 2;
+
+  // Oversampling: a new factor or filter is prepared on the message thread;
+  // until it is published we keep running the current one. The switch
+  // dips the wet part like a Pre/Post switch: the new oversampler takes
+  // over once the wet part is out, and it fades back in once the new
+  // filters have filled (oversamplingSettleSamples).
+  const int wantedOversampling = getWantedOversampling();
+  requestedOversampling.store(wantedOversampling, std::memory_order_relaxed);
+  requestedReference.store(getWantedOversampling(false),
+                           std::memory_order_relaxed);
+  const int preparedIndex = preparedOversampling.load(std::memory_order_acquire);
+  if (preparedIndex < 0) // prepareToPlay() has not run yet
+    return;
+  // Published before the index (a newer value is picked up by the next
+  // switch)
+  const int latency = preparedLatency.load();
+  if ((preparedIndex != activeOversampling.load() || latency != latencyInUse) &&
+      (wetSmoothed == 0.0f || snapCrossfades)) {
+    activeOversampling = preparedIndex;
+    latencyInUse = latency;
+    const auto &prepared = *oversamplers[(size_t)preparedIndex];
+    waveshaperTable.prepare(getSampleRate() * prepared.getOversamplingFactor());
+    adaaStates = {};
+    setDryDelay(latency);
+    wetDelaySamples = juce::jlimit(
+        0, maxDryDelay - 1,
+        latency - juce::roundToInt(prepared.getLatencyInSamples()));
+    oversamplingSettleSamples = snapCrossfades ? 0 : 2 * latency;
   }
+  auto &oversampling = *oversamplers[(size_t)activeOversampling.load()];
+  context.oversampling = &oversampling;
 
-  // Get waveshape selection
-  int waveshapeIndex =
-      static_cast<int>(*apvts.getRawParameterValue("waveshape"));
-
-  // 4. Pre/Post Processing Logic
-
-  auto processBands = [&](juce::AudioBuffer<float> &audio) {
-    // --- Standard 3-Band Linkwitz-Riley Crossover ---
-
-    // 1. Create clean copies of the input signal for each filter chain.
-    lowBuffer.makeCopyOf(audio);
-    midBuffer.makeCopyOf(audio);
-    highBuffer.makeCopyOf(audio);
-
-    // 2. Create the LOW band signal.
-    juce::dsp::AudioBlock<float> lowBlock(lowBuffer);
-    lp1.process(juce::dsp::ProcessContextReplacing<float>(
-        lowBlock)); // Low-pass at lowFreq
-
-    // 3. Create the HIGH band signal.
-    juce::dsp::AudioBlock<float> highBlock(highBuffer);
-    hp2.process(juce::dsp::ProcessContextReplacing<float>(
-        highBlock)); // High-pass at highFreq
-
-    // 4. Create the MID band signal.
-    juce::dsp::AudioBlock<float> midBlock(midBuffer);
-    hp1.process(juce::dsp::ProcessContextReplacing<float>(
-        midBlock)); // High-pass at lowFreq
-    lp2.process(juce::dsp::ProcessContextReplacing<float>(
-        midBlock)); // Low-pass at highFreq
-
-    // --- Per-Band Processing (In-Place) ---
-    // If a band is enabled, its corresponding buffer is processed directly.
-    // If not, the buffer contains the original, unprocessed audio for that
-    // band.
-    if (lowEnable) {
-      for (int channel = 0; channel < lowBuffer.getNumChannels(); ++channel) {
-        auto *data = lowBuffer.getWritePointer(channel);
-        for (int i = 0; i < lowBuffer.getNumSamples(); ++i) {
-          float x = data[i];
-          data[i] = x + (x * std::abs(x)) * lowWarmth;
+  // 2. Gain Staging
+  // Store a clean copy of the input signal for the Dry/Wet mix.
+  const int numChannels = buffer.getNumChannels();
+  const int numSamples = buffer.getNumSamples();
+  context.numChannels = numChannels;
+  context.numSamples = numSamples;
+
+  // Gains: glide one chunk further (see BlockRamp.h)
+  if (snapCrossfades)
+    for (auto &ramp : ramps)
+      ramp.snapToTarget();
+  for (auto &ramp : ramps)
+    ramp.advance(numSamples);
+  bands.lowLevel = ramps[lowLevelRamp].getValue();
+  bands.lowLevelRamp = ramps[lowLevelRamp].isMoving()
+                           ? ramps[lowLevelRamp].getRamp()
+                           : nullptr;
+  bands.highLevel = ramps[highLevelRamp].getValue();
+  bands.highLevelRamp = ramps[highLevelRamp].isMoving()
+                            ? ramps[highLevelRamp].getRamp()
+                            : nullptr;
+  context.mix = ramps[mixRamp].getValue();
+  context.deltaGain = ramps[deltaGainRamp].getValue();
+  context.outputGain = ramps[outputGainRamp].getValue();
+  context.gainsMoving = ramps[mixRamp].isMoving() ||
+                        ramps[deltaGainRamp].isMoving() ||
+                        ramps[outputGainRamp].isMoving();
+
+  // Dual mono detection, on the raw input (see dualMono)
+  const bool identicalInput =
+      numChannels == 2 &&
+      std::memcmp(buffer.getReadPointer(0), buffer.getReadPointer(1),
+                  sizeof(float) * (size_t)numSamples) == 0;
+  const int holdSamples = (int)(dualMonoHoldSeconds * getSampleRate());
+  identicalInputSamples =
+      identicalInput ? juce::jmin(identicalInputSamples + numSamples,
+                                  holdSamples)
+                     : 0;
+  const bool wasDualMono = dualMono;
+  dualMono = identicalInput && identicalInputSamples >= holdSamples;
+  if (dualMono)
+    context.numChannels = 1;
+  dryBuffer.setSize(numChannels, numSamples, false, false, true);
+  for (int channel = 0; channel < numChannels; ++channel)
+    dryBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+
+  // Delay it by the oversampling latency, so that mixing and delta
+  // monitoring do not comb-filter. A new length crossfades from the old
+  // one (see setDryDelay()).
+  {
+    const int numDrySamples = dryBuffer.getNumSamples();
+    const int numDryChannels =
+        juce::jmin(dryBuffer.getNumChannels(), dryDelayLine.getNumChannels());
+    float fadeEnd = dryDelayFade;
+    for (int channel = 0; channel < numDryChannels; ++channel) {
+      auto *data = dryBuffer.getWritePointer(channel);
+      auto *line = dryDelayLine.getWritePointer(channel);
+      int writePosition = dryDelayWritePosition;
+      if (dryDelayFade >= 1.0f) {
+        for (int i = 0; i < numDrySamples; ++i) {
+          line[writePosition] = data[i];
+          data[i] = line[(writePosition - dryDelaySamples + maxDryDelay) %
+                         maxDryDelay];
+          writePosition = (writePosition + 1) % maxDryDelay;
         }
-      }
-      lowBuffer.applyGain(lowLevel);
-    }
-
-    if (highEnable) {
-      for (int channel = 0; channel < highBuffer.getNumChannels(); ++channel) {
-        auto *data = highBuffer.getWritePointer(channel);
-        for (int i = 0; i < highBuffer.getNumSamples(); ++i) {
-          float x = data[i];
-          data[i] = x - std::tanh(x * highSoftness);
+      } else {
+        float fade = dryDelayFade;
+        for (int i = 0; i < numDrySamples; ++i) {
+          line[writePosition] = data[i];
+          const float previous =
+              line[(writePosition - previousDryDelaySamples + maxDryDelay) %
+                   maxDryDelay];
+          const float current =
+              line[(writePosition - dryDelaySamples + maxDryDelay) %
+                   maxDryDelay];
+          fade = juce::jmin(fade + routingCrossfadeStep, 1.0f);
+          data[i] = previous + (current - previous) * fade;
+          writePosition = (writePosition + 1) % maxDryDelay;
         }
+        fadeEnd = fade;
       }
-      highBuffer.applyGain(highLevel);
     }
+    dryDelayFade = fadeEnd;
+    dryDelayWritePosition = (dryDelayWritePosition + numDrySamples) % maxDryDelay;
+  }
 
-    // --- Recombine Bands (No Copies Needed) ---
-    // All member buffers are now in their final state (either processed or
-    // unprocessed). We can now safely sum them into the main output buffer.
-    audio.clear();
-    for (int channel = 0; channel < audio.getNumChannels(); ++channel) {
-      audio.addFrom(channel, 0, lowBuffer, channel, 0, audio.getNumSamples());
-      audio.addFrom(channel, 0, midBuffer, channel, 0, audio.getNumSamples());
-      audio.addFrom(channel, 0, highBuffer, channel, 0, audio.getNumSamples());
-    }
-  };
+  // Bypass: the delayed dry signal, so the latency stays the same. Once
+  // the crossfade is over nothing else runs, and switches apply at once.
+  const bool bypass = p.getBool(Params::bypass);
+  if (bypass && bypassSmoothed == 1.0f) {
+    for (int channel = 0; channel < numChannels; ++channel)
+      buffer.copyFrom(channel, 0, dryBuffer, channel, 0, numSamples);
+    governorLevel.store(pendingGovernorLevel, std::memory_order_relaxed);
+    oversamplingSettleSamples = 0;
+    snapCrossfades = true;
+    bypassStale = true;
+    const StageTimings::Scope timing(stageTimings, StageTimings::analyzerPush);
+    analyzerTap.pushSamples(dryBuffer, buffer);
+    return;
+  }
+  // Back from bypass: the filters start from silence, and the dry signal
+  // is held until they have filled
+  if (bypassStale) {
+    resetProcessing();
+    bypassStale = false;
+    bypassHoldSamples = 2 * latencyInUse;
+  }
 
-  // Lambda to apply selected waveshape to a single sample
-  auto applyWaveshape = [&](float x, int waveshape, float shapeParam) -> float {
-    float output = x;
-    switch (waveshape) {
-    case 0: // Tube
-    {
-      float soft = std::tanh(x * (1.0f - shapeParam * 0.5f));
-      float hard = (x - x * x * x / 3.0f);
-      output = soft * (1.0f - shapeParam) + hard * shapeParam;
-      break;
-    }
-    case 1: // SoftClip
-      output = std::tanh(x * (1.0f + shapeParam * 2.0f));
-      break;
-    case 2: // HardClip
-      output = juce::jlimit(-1.0f, 1.0f, x * (1.0f + shapeParam * 3.0f));
-      break;
-    case 3: // Diode 1
-      output = x > 0.0f ? std::tanh(x * (1.0f + shapeParam)) : x * 0.5f;
-      break;
-    case 4: // Diode 2
-      output = x > 0.0f ? x * 0.7f : std::tanh(x * (1.0f + shapeParam * 2.0f));
-      break;
-    case 5: // Linear Fold
-    {
-      float threshold = 1.0f - shapeParam * 0.5f;
-      if (std::abs(x) > threshold)
-        output = threshold - (std::abs(x) - threshold);
-      else
-        output = x;
-      output = juce::jlimit(-1.0f, 1.0f, output);
-      break;
-    }
-    case 6: // Sin Fold
-      output = std::sin(x * juce::MathConstants<float>::pi *
-                        (1.0f + shapeParam * 2.0f));
-      break;
-    case 7: // Zero-Square
-      output = x * x * (x > 0.0f ? 1.0f : -1.0f) * (1.0f + shapeParam);
-      break;
-    case 8: // Downsample (simplified for oversampling context)
-      output = std::tanh(x * (1.0f + shapeParam));
-      break;
-    case 9: // Asym
-      output = x > 0.0f ? std::tanh(x * (1.0f + shapeParam * 2.0f)) : x * 0.3f;
-      break;
-    case 10: // Rectify
-      output = std::abs(x) * (1.0f - shapeParam * 0.5f);
-      break;
-    case 11: // X-Shaper
-      output = x * (1.0f + shapeParam) / (1.0f + shapeParam * std::abs(x));
-      break;
-    case 12: // X-Shaper (Asym)
-      output = x > 0.0f ? x * (1.0f + shapeParam * 2.0f) /
-                              (1.0f + shapeParam * std::abs(x))
-                        : x * 0.5f;
-      break;
-    case 13: // Sine Shaper
-      output = std::sin(std::tanh(x) * juce::MathConstants<float>::pi * 0.5f *
-                        (1.0f + shapeParam));
-      break;
-    case 14: // Stomp Box
-      output = std::atan(x * (1.0f + shapeParam * 5.0f)) /
-               juce::MathConstants<float>::pi;
-      break;
-    case 15: // Tape Sat.
-    {
-      float wet = std::tanh(x * 1.5f);
-      output = x * (1.0f - shapeParam) + wet * shapeParam;
-      break;
-    }
-    case 16: // Overdrive
-      output = (2.0f / juce::MathConstants<float>::pi) *
-               std::atan(x * (1.0f + shapeParam * 10.0f));
-      break;
-    case 17: // Soft Sat.
-      output = x / (1.0f + std::abs(x) * shapeParam);
-      break;
-    case 18: // Bit-Crush
-    {
-      float levels = 2.0f + (1.0f - shapeParam) * 30.0f;
-      output = std::round(x * levels) / levels;
-      break;
-    }
-    case 19: // Glitch Fold
-      output = x * std::sin(x * shapeParam * juce::MathConstants<float>::pi);
-      break;
-    case 20: // Valve
-    {
-      float bias = 0.2f * shapeParam;
-      float x_biased = x + bias;
-      output = x_biased / (1.0f + std::abs(x_biased));
-      break;
-    }
-    case 21: // Fuzz Fac
-      output = (x > 0.0f ? 1.0f : -1.0f) *
-               (1.0f - std::exp(-std::abs(x * (1.0f + shapeParam * 10.0f))));
-      break;
-    case 22: // Cheby 3
-    {
-      float x_limited = juce::jlimit(-1.0f, 1.0f, x);
-      output = (4.0f * x_limited * x_limited * x_limited - 3.0f * x_limited) *
-               (0.5f + shapeParam * 0.5f);
-      break;
-    }
-    case 23: // Cheby 5
-    {
-      float x_limited = juce::jlimit(-1.0f, 1.0f, x);
-      output = (16.0f * std::pow(x_limited, 5) -
-                20.0f * std::pow(x_limited, 3) + 5.0f * x_limited) *
-               (0.5f + shapeParam * 0.5f);
-      break;
-    }
-    case 24: // Log Sat
-      output = (x > 0.0f ? 1.0f : -1.0f) *
-               std::log(1.0f + (10.0f + shapeParam * 50.0f) * std::abs(x)) /
-               std::log(11.0f + shapeParam * 50.0f);
-      break;
-    case 25: // Half Wave
-      output = x > 0.0f ? std::tanh(x * (1.0f + shapeParam)) : x;
-      break;
-    case 26: // Cubic
-    {
-      float x_scaled = x * (1.0f + shapeParam);
-      output = x_scaled - (1.0f / 3.0f) * x_scaled * x_scaled * x_scaled;
-      break;
-    }
-    case 27: // Octaver Sat
-      output = (std::abs(x) * 2.0f - 1.0f) * (0.5f + shapeParam * 0.5f);
-      break;
-
-    // ========== NEW WAVESHAPES (28-57) ==========
-
-    // === TUBE TYPES (28-33) - Inspired by Decapitator ===
-    case 28: // Triode - Classic 12AX7 warmth
-    {
-      float mu = 100.0f; // Amplification factor
-      float kp = 1.2f + shapeParam * 0.8f;
-      float vg = x * (1.0f + shapeParam);
-      output = (vg > 0.0f) ? std::tanh(vg / kp) * kp
-                           : vg / (1.0f + std::abs(vg) * mu * 0.01f);
-      break;
-    }
-    case 29: // Pentode - EL34 power tube push
-    {
-      float screen = 0.7f + shapeParam * 0.3f;
-      float plate = x * (1.5f + shapeParam);
-      output = std::tanh(plate * screen) +
-               0.1f * std::sin(plate * 3.0f) * shapeParam;
-      break;
-    }
-    case 30: // Class A - Single-ended warmth
-    {
-      float bias = 0.3f * shapeParam;
-      float biased = x + bias;
-      output = std::tanh(biased * (1.0f + shapeParam)) - bias * 0.5f;
-      break;
-    }
-    case 31: // Class AB - Push-pull punch
-    {
-      float threshold = 0.3f - shapeParam * 0.2f;
-      if (std::abs(x) < threshold) {
-        output = x * (1.0f + shapeParam * 2.0f);
-      } else {
-        output = (x > 0.0f ? 1.0f : -1.0f) *
-                 (threshold + std::tanh((std::abs(x) - threshold) *
-                                        (2.0f + shapeParam * 3.0f)));
-      }
-      break;
-    }
-    case 32: // Class B - Crossover distortion
-    {
-      float deadzone = 0.05f + shapeParam * 0.1f;
-      if (std::abs(x) < deadzone) {
-        output = 0.0f;
-      } else {
-        output =
-            (x > 0.0f ? 1.0f : -1.0f) *
-            std::tanh((std::abs(x) - deadzone) * (1.0f + shapeParam * 3.0f));
-      }
-      break;
-    }
-    case 33: // Germanium - Vintage transistor fuzz
-    {
-      float temp = 0.8f + shapeParam * 0.4f; // Temperature coefficient
-      float biased = x + 0.1f * shapeParam;
-      output = (biased > 0.0f ? 1.0f : -1.0f) *
-               (1.0f - std::exp(-std::abs(biased) * temp * 5.0f));
-      output *= 0.9f + 0.1f * shapeParam;
-      break;
-    }
+  // Apply Input Gain
+  {
+    const StageTimings::Scope timing(stageTimings, StageTimings::inputGain);
+    for (int channel = 0; channel < context.numChannels; ++channel)
+      ramps[inputGainRamp].apply(buffer.getWritePointer(channel), numSamples);
+  }
 
-    // === TAPE MODES (34-38) - Inspired by Saturn ===
-    case 34: // Tape 15ips - Fast tape, bright
-    {
-      float headroom = 1.2f - shapeParam * 0.3f;
-      float compression = std::tanh(x / headroom) * headroom;
-      output = compression + 0.05f * x * shapeParam; // Some HF retention
-      break;
-    }
-    case 35: // Tape 7.5ips - Slow tape, warm
-    {
-      float satPoint = 0.6f + shapeParam * 0.3f;
-      float warmth = x + 0.15f * x * x * (x > 0.0f ? 1.0f : -1.0f);
-      output = std::tanh(warmth / satPoint) * satPoint;
-      break;
-    }
-    case 36: // Tape Cassette - Lo-fi cassette
-    {
-      float hfLoss = 1.0f - shapeParam * 0.4f;
-      float saturated = std::tanh(x * (1.0f + shapeParam * 2.0f));
-      output = saturated * hfLoss + x * (1.0f - hfLoss) * 0.5f;
-      break;
-    }
-    case 37: // Tape 456 - Ampex 456 style (famous for punchy low end)
-    {
-      float hysteresis = x + 0.2f * x * std::abs(x) * shapeParam;
-      output = std::tanh(hysteresis * (1.0f + shapeParam * 0.5f));
-      break;
-    }
-    case 38: // Tape SM900 - Modern tape emulation
-    {
-      float modern = std::tanh(x * 1.1f);
-      float vintage = x / (1.0f + std::abs(x) * 0.5f);
-      output = modern * (1.0f - shapeParam) + vintage * shapeParam;
-      break;
-    }
+  // 3. Update Filter Coefficients (if needed)
+  crossover.setCutoffs(p.get(Params::lowFreq), p.get(Params::highFreq));
 
-    // === TRANSFORMER (39-42) ===
-    case 39: // Transformer - Iron saturation
-    {
-      float iron = x + 0.3f * std::sin(x * 2.0f) * shapeParam;
-      output = std::tanh(iron * (1.0f + shapeParam));
-      break;
-    }
-    case 40: // Console - Neve-style console
-    {
-      float harmonic2 = 0.1f * x * std::abs(x) * shapeParam;
-      float harmonic3 = 0.05f * x * x * x * shapeParam;
-      output = std::tanh(x + harmonic2 + harmonic3);
-      break;
-    }
-    case 41: // API Style - API 2500 character (punchy)
-    {
-      float punch = x * (1.0f + shapeParam * 0.5f);
-      float clipped = juce::jlimit(-1.0f, 1.0f, punch * 1.5f);
-      output = punch * (1.0f - shapeParam * 0.5f) + clipped * shapeParam * 0.5f;
-      output = std::tanh(output);
-      break;
-    }
-    case 42: // SSL Style - SSL G-Series (clean but present)
-    {
-      float compressed = x / (1.0f + std::abs(x) * shapeParam * 0.5f);
-      float harmonic = 0.05f * x * x * x * shapeParam;
-      output = compressed + harmonic;
-      break;
-    }
+  // Get waveshape selection
+  context.waveshapeIndex = p.getInt(Params::waveshape);
+  const int waveshapeIndex = context.waveshapeIndex;
+
+  // Pick the block kernel for the selected waveshape once per block, so the
+  // per-sample loop runs a single inlined (and vectorized) curve instead of a
+  // 58-case switch.
+  context.waveshapeKernel =
+      juce::isPositiveAndBelow(waveshapeIndex, Waveshapers::numWaveshapes)
+          ? (*waveshaperKernels[static_cast<size_t>(quality)])
+                [static_cast<size_t>(waveshapeIndex)]
+          : Waveshapers::getBlockKernel(waveshapeIndex);
+  context.drive = ramps[driveRamp].getValue();
+  context.driveMoving = ramps[driveRamp].isMoving();
+
+  // ADAA uses a closed-form antiderivative when the curve has one, the
+  // table's antiderivative otherwise.
+  context.adaaClosedForm =
+      context.adaaMode && Adaa::hasClosedForm(waveshapeIndex);
+
+  // Table and ADAA modes fall back to the direct kernel until the first
+  // table for this waveshape has been built (and for Crackle, which is
+  // random). Offline the table is built right here, so a bounce does not
+  // depend on the background thread's timing.
+  context.useTable =
+      (tableMode || (context.adaaMode && !context.adaaClosedForm)) &&
+      WaveshaperTable::supports(waveshapeIndex) &&
+      waveshaperTable.beginBlock(waveshapeIndex, context.shape,
+                                 isNonRealtime());
+
+  if (wasDualMono && !dualMono)
+    leaveDualMono(context);
+
+  // 4. Routing: pick the pipeline for this chunk. Switches crossfade
+  // (~10 ms) through the Fading variants.
+  if (snapCrossfades) {
+    deltaSmoothed = deltaEnabled ? 1.0f : 0.0f;
+    limiterSmoothed = limiterEnable ? 1.0f : 0.0f;
+    activePrePost = prePost;
+    wetSmoothed = 1.0f;
+    snapCrossfades = false;
+  }
 
-    // === TRANSISTOR (43-47) ===
-    case 43: // Silicon - Modern transistor
-    {
-      float gain = 1.0f + shapeParam * 3.0f;
-      float clipPoint = 0.8f - shapeParam * 0.2f;
-      output = juce::jlimit(-clipPoint, clipPoint, x * gain);
-      output = std::tanh(output / clipPoint) * clipPoint;
-      break;
-    }
-    case 44: // FET Clean - FET limiter style (1176 clean)
-    {
-      float ratio = 4.0f + shapeParam * 16.0f;
-      float threshold = 0.5f;
-      if (std::abs(x) > threshold) {
-        float excess = std::abs(x) - threshold;
-        output = (x > 0.0f ? 1.0f : -1.0f) * (threshold + excess / ratio);
-      } else {
-        output = x;
+  const auto stateOf = [](float smoothed, bool enabled) {
+    if (smoothed == (enabled ? 1.0f : 0.0f))
+      return enabled ? StageState::On : StageState::Off;
+    return StageState::Fading;
+  };
+  const auto deltaState = stateOf(deltaSmoothed, deltaEnabled);
+  const auto limiterState = stateOf(limiterSmoothed, limiterEnable);
+  if (limiterState == StageState::Fading && limiterSmoothed == 0.0f)
+    limiter.reset(); // fading in from bypass
+
+  // A Pre/Post change, an oversampling switch or a governor step dips the
+  // wet part through the mix stage
+  const bool oversamplingSwitching =
+      wantedOversampling != activeOversampling.load() ||
+      preparedIndex != activeOversampling.load() ||
+      latency != latencyInUse || oversamplingSettleSamples > 0;
+  const bool governorSwitching = pendingGovernorLevel != governor;
+  context.wetTarget = activePrePost == prePost && !oversamplingSwitching &&
+                              !governorSwitching
+                          ? 1.0f
+                          : 0.0f;
+  const bool mixed = context.mix < 1.0f || ramps[mixRamp].isMoving() ||
+                     wetSmoothed < 1.0f || context.wetTarget < 1.0f;
+
+  static constexpr auto pipelines =
+      makePipelines(std::make_index_sequence<numPipelines>());
+  const int pipelineIndex = (activePrePost ? 18 : 0) + (int)deltaState * 6 +
+                            (int)limiterState * 2 + (mixed ? 1 : 0);
+  (this->*pipelines[(size_t)pipelineIndex])(buffer, context);
+
+  // Once the wet part is out, switch the order; it fades back in from the
+  // next chunk on
+  if (activePrePost != prePost && wetSmoothed == 0.0f)
+    activePrePost = prePost;
+
+  // The same for a governor step. A new oversampling factor is then
+  // prepared on the message thread, and the wet part stays out until it
+  // runs (oversamplingSwitching).
+  if (pendingGovernorLevel != governor && wetSmoothed == 0.0f)
+    governorLevel.store(pendingGovernorLevel, std::memory_order_relaxed);
+  oversamplingSettleSamples =
+      juce::jmax(0, oversamplingSettleSamples - numSamples);
+
+  // Bypass crossfade, after the limiter
+  if (bypass || bypassSmoothed > 0.0f) {
+    const float target = bypass || bypassHoldSamples > 0 ? 1.0f : 0.0f;
+    float amount = bypassSmoothed;
+    for (int channel = 0; channel < numChannels; ++channel) {
+      auto *data = buffer.getWritePointer(channel);
+      const auto *dry = dryBuffer.getReadPointer(channel);
+      amount = bypassSmoothed;
+      for (int i = 0; i < numSamples; ++i) {
+        amount = target > amount
+                     ? juce::jmin(amount + routingCrossfadeStep, target)
+                     : juce::jmax(amount - routingCrossfadeStep, target);
+        data[i] += (dry[i] - data[i]) * amount;
       }
-      break;
-    }
-    case 45: // FET Dirty - FET pushed hard (1176 all-buttons)
-    {
-      float attack = x * (2.0f + shapeParam * 4.0f);
-      output = std::tanh(attack) * (0.8f + shapeParam * 0.2f);
-      output += 0.1f * std::sin(x * 5.0f) * shapeParam; // Harmonics
-      break;
-    }
-    case 46: // OpAmp - IC distortion
-    {
-      float gain = 1.0f + shapeParam * 10.0f;
-      float clipped = juce::jlimit(-1.0f, 1.0f, x * gain);
-      output = clipped * (1.0f - shapeParam * 0.3f) +
-               std::tanh(x * gain) * shapeParam * 0.3f;
-      break;
-    }
-    case 47: // CMOS - Digital/analog hybrid
-    {
-      float digital = (x > 0.0f ? 1.0f : -1.0f) * std::pow(std::abs(x), 0.5f);
-      float analog = std::tanh(x * (1.0f + shapeParam));
-      output = digital * shapeParam + analog * (1.0f - shapeParam);
-      break;
-    }
-
-    // === CREATIVE (48-52) - Inspired by Trash 2 ===
-    case 48: // Scream - Aggressive screamer
-    {
-      float scream = x * (3.0f + shapeParam * 7.0f);
-      output = std::tanh(scream) + 0.2f * std::sin(scream * 3.0f) * shapeParam;
-      output = juce::jlimit(-1.0f, 1.0f, output);
-      break;
-    }
-    case 49: // Buzz - Buzzy distortion
-    {
-      float buzz = x + 0.3f * std::sin(x * 10.0f * (1.0f + shapeParam * 5.0f));
-      output = std::tanh(buzz * (1.0f + shapeParam));
-      break;
-    }
-    case 50: // Crackle - Subtle noise/crackle character
-    {
-      float noise =
-          (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 0.02f * shapeParam;
-      output = std::tanh(x * (1.0f + shapeParam * 2.0f)) + noise * std::abs(x);
-      break;
-    }
-    case 51: // Wrap - Wrap-around distortion
-    {
-      float wrapped = x * (1.0f + shapeParam * 3.0f);
-      wrapped = std::fmod(wrapped + 3.0f, 2.0f) - 1.0f;
-      output = wrapped;
-      break;
-    }
-    case 52: // Density - Thick density
-    {
-      float density = std::tanh(x * 2.0f) + std::tanh(x * 0.5f);
-      output = density * 0.5f * (1.0f + shapeParam * 0.5f);
-      break;
     }
+    bypassSmoothed = amount;
+  }
+  bypassHoldSamples = juce::jmax(0, bypassHoldSamples - numSamples);
 
-    // === MATH/EXOTIC (53-57) ===
-    case 53: // Cheby 7 - 7th order Chebyshev
-    {
-      float xl = juce::jlimit(-1.0f, 1.0f, x);
-      float x2 = xl * xl;
-      float x3 = x2 * xl;
-      float x5 = x3 * x2;
-      float x7 = x5 * x2;
-      output = (64.0f * x7 - 112.0f * x5 + 56.0f * x3 - 7.0f * xl) *
-               (0.3f + shapeParam * 0.7f);
-      break;
-    }
-    case 54: // Hyperbolic - sinh based
-    {
-      float scale = 0.5f + shapeParam * 1.5f;
-      output = std::sinh(x * scale) / std::cosh(x * scale * 2.0f);
-      break;
-    }
-    case 55: // Exponential - exp based limiting
-    {
-      float sign = x > 0.0f ? 1.0f : -1.0f;
-      float absX = std::abs(x);
-      float rate = 2.0f + shapeParam * 4.0f;
-      output = sign * (1.0f - std::exp(-absX * rate));
-      break;
-    }
-    case 56: // Parabolic - Parabolic curve
-    {
-      float scaled = x * (1.0f + shapeParam * 2.0f);
-      if (std::abs(scaled) < 1.0f) {
-        output = scaled - (scaled * scaled * scaled) / 3.0f;
-      } else {
-        output = (scaled > 0.0f ? 1.0f : -1.0f) * (2.0f / 3.0f);
-      }
-      break;
-    }
-    case 57: // Wavelet - Wavelet-inspired (Mexican hat)
-    {
-      float t = x * (2.0f + shapeParam * 4.0f);
-      float t2 = t * t;
-      output = (1.0f - t2) * std::exp(-t2 * 0.5f);
-      output *= (1.0f + shapeParam);
-      break;
-    }
+  const StageTimings::Scope timing(stageTimings, StageTimings::analyzerPush);
+  analyzerTap.pushSamples(dryBuffer, buffer);
+}
 
-    default:
-      output = std::tanh(x);
-      break;
-    }
-    return output;
+template <bool post, Vst_saturatorAudioProcessor::StageState delta,
+          Vst_saturatorAudioProcessor::StageState limiting, bool mixed>
+void Vst_saturatorAudioProcessor::runPipeline(
+    juce::AudioBuffer<float> &buffer, const ChunkContext &context) {
+  const int numChannels = context.numChannels;
+  const int numSamples = context.numSamples;
+  const float step = routingCrossfadeStep;
+  const auto moveTowards = [step](float value, float target) {
+    return value < target ? juce::jmin(value + step, target)
+                          : juce::jmax(value - step, target);
   };
 
-  if (prePost) // Post: EQ -> Saturation
-  {
-    // 1. Process bands first
-    processBands(buffer);
-
-    // 2. Then apply oversampled saturation with selected waveshape
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::AudioBlock<float> oversampledBlock =
-        oversampling.processSamplesUp(block);
-
-    float drive = juce::Decibels::decibelsToGain(saturation);
-    for (int channel = 0; channel < (int)oversampledBlock.getNumChannels();
-         ++channel) {
-      auto *channelData = oversampledBlock.getChannelPointer(channel);
-      for (size_t sample = 0; sample < oversampledBlock.getNumSamples();
-           ++sample) {
-        float x = channelData[sample] * drive;
-        channelData[sample] = applyWaveshape(x, waveshapeIndex, shape);
-      }
-    }
-    oversampling.processSamplesDown(block);
-  } else // Pre: Saturation -> EQ
-  {
-    // 1. Apply oversampled saturation first with selected waveshape
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::AudioBlock<float> oversampledBlock =
-        oversampling.processSamplesUp(block);
-
-    float drive = juce::Decibels::decibelsToGain(saturation);
-    for (int channel = 0; channel < (int)oversampledBlock.getNumChannels();
-         ++channel) {
-      auto *channelData = oversampledBlock.getChannelPointer(channel);
-      for (size_t sample = 0; sample < oversampledBlock.getNumSamples();
-           ++sample) {
-        float x = channelData[sample] * drive;
-        channelData[sample] = applyWaveshape(x, waveshapeIndex, shape);
-      }
-    }
-    oversampling.processSamplesDown(block);
+  const auto processCrossover = [&] {
+    const StageTimings::Scope timing(stageTimings, StageTimings::crossover);
+    crossover.process(buffer.getArrayOfWritePointers(), numChannels,
+                      numSamples, context.bands);
+  };
 
-    // 2. Then process bands
-    processBands(buffer);
+  // Pre/Post Processing Logic
+  if constexpr (post) { // Post: EQ -> Saturation
+    processCrossover();
+    processSaturation(buffer, context);
+  } else { // Pre: Saturation -> EQ
+    processSaturation(buffer, context);
+    processCrossover();
   }
 
+  // Below the full-quality factor (CPU governor), pad the wet part up to
+  // the reported latency
+  if (wetDelaySamples > 0)
+    delayWet(buffer, numChannels, numSamples);
+
   // 5. Final Stage: Delta Monitor / Mix, Output Gain, Limiter
   //
   // DELTA MODE: Output = safety((wet - dry) * deltaGain)
@@ -889,89 +993,342 @@ void Vst_saturatorAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
   // - Uses tanh soft clipper for safety
   // - Crossfades smoothly to avoid clicks
   //
-  // NORMAL MODE: Output = dry * (1 - mix) + wet * mix
-
-  for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
-    auto *channelData = buffer.getWritePointer(channel);
-    auto *dryData = dryBuffer.getReadPointer(channel);
-
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-      float wetSignal = channelData[sample];
-      float drySignal = dryData[sample];
-
-      // Update deltaSmoothed towards target (per-sample for smooth crossfade)
-      if (deltaSmoothed < targetDeltaSmoothed) {
-        deltaSmoothed =
-            juce::jmin(deltaSmoothed + deltaCrossfadeStep, targetDeltaSmoothed);
-      } else if (deltaSmoothed > targetDeltaSmoothed) {
-        deltaSmoothed =
-            juce::jmax(deltaSmoothed - deltaCrossfadeStep, targetDeltaSmoothed);
+  // NORMAL MODE: Output = dry + (wet - dry) * mix
+  //
+  // The wet part is also scaled by wetSmoothed (Pre/Post switches).
+  if constexpr (mixed || delta != StageState::Off) {
+    const StageTimings::Scope timing(stageTimings, StageTimings::mixDelta);
+    const float deltaTarget = parameters.getBool(Params::delta) ? 1.0f : 0.0f;
+    const float wetTarget = context.wetTarget;
+    float deltaEnd = deltaSmoothed, wetEnd = wetSmoothed;
+
+    // gainsAt(sample) returns {mix, deltaGain, outputGain}: the constants,
+    // or the ramps while one of them moves (one loop is compiled for each)
+    const auto mixChannels = [&](auto gainsAt) {
+      for (int channel = 0; channel < numChannels; ++channel) {
+        auto *channelData = buffer.getWritePointer(channel);
+        auto *dryData = dryBuffer.getReadPointer(channel);
+        float deltaAmount = deltaSmoothed;
+        float wetAmount = wetSmoothed;
+
+        for (int sample = 0; sample < numSamples; ++sample) {
+          const float wetSignal = channelData[sample];
+          const float drySignal = dryData[sample];
+          const auto gains = gainsAt(sample);
+
+          float difference = wetSignal - drySignal;
+          if constexpr (mixed) {
+            wetAmount = moveTowards(wetAmount, wetTarget);
+            difference *= wetAmount;
+          }
+
+          float output = wetSignal;
+          if constexpr (mixed && delta != StageState::On)
+            output = drySignal + difference * gains.mix;
+
+          if constexpr (delta != StageState::Off) {
+            // Safety soft clipper for delta (tanh clips to -1..+1 range)
+            const float deltaOutput =
+                context.tanh(difference * gains.deltaGain);
+            if constexpr (delta == StageState::On) {
+              output = deltaOutput;
+            } else {
+              deltaAmount = moveTowards(deltaAmount, deltaTarget);
+              output += (deltaOutput - output) * deltaAmount;
+            }
+          }
+
+          // Output Gain before Limiter
+          channelData[sample] = output * gains.outputGain;
+        }
+
+        deltaEnd = deltaAmount;
+        wetEnd = wetAmount;
       }
+    };
+
+    struct Gains {
+      float mix, deltaGain, outputGain;
+    };
+    if (context.gainsMoving) {
+      const float *mixes = ramps[mixRamp].getRamp();
+      const float *deltaGains = ramps[deltaGainRamp].getRamp();
+      const float *outputGains = ramps[outputGainRamp].getRamp();
+      mixChannels([=](int sample) {
+        return Gains{mixes[sample], deltaGains[sample], outputGains[sample]};
+      });
+    } else {
+      mixChannels([&context](int) {
+        return Gains{context.mix, context.deltaGain, context.outputGain};
+      });
+    }
 
-      // Calculate normal mix output
-      float normalOutput = drySignal * (1.0f - mix) + wetSignal * mix;
+    if constexpr (delta == StageState::Fading)
+      deltaSmoothed = deltaEnd;
+    if constexpr (mixed)
+      wetSmoothed = wetEnd;
+  } else {
+    // Apply Output Gain before Limiter
+    const StageTimings::Scope timing(stageTimings, StageTimings::outputGain);
+    for (int channel = 0; channel < numChannels; ++channel)
+      ramps[outputGainRamp].apply(buffer.getWritePointer(channel), numSamples);
+  }
 
-      // Calculate delta output: (100% wet - dry) * deltaGain
-      // Note: For delta, we use the full wet signal minus dry (ignoring mix)
-      float deltaRaw = (wetSignal - drySignal) * deltaGain;
+  // Dual mono: the right channel is a copy of the left one
+  for (int channel = numChannels; channel < buffer.getNumChannels(); ++channel)
+    buffer.copyFrom(channel, 0, buffer, 0, 0, numSamples);
 
-      // Safety soft clipper for delta (tanh clips to -1..+1 range)
-      float deltaOutput = std::tanh(deltaRaw);
+  if constexpr (limiting == StageState::On) {
+    const StageTimings::Scope timing(stageTimings, StageTimings::limiter);
+    juce::dsp::AudioBlock<float> block(buffer);
+    limiter.process(juce::dsp::ProcessContextReplacing<float>(block));
+  } else if constexpr (limiting == StageState::Fading) {
+    const StageTimings::Scope timing(stageTimings, StageTimings::limiter);
+    const int numLimiterChannels = buffer.getNumChannels();
+    limiterBuffer.setSize(numLimiterChannels, numSamples, false, false, true);
+    for (int channel = 0; channel < numLimiterChannels; ++channel)
+      limiterBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+    juce::dsp::AudioBlock<float> block(limiterBuffer);
+    limiter.process(juce::dsp::ProcessContextReplacing<float>(block));
 
-      // Crossfade between normal and delta mode
-      channelData[sample] =
-          normalOutput * (1.0f - deltaSmoothed) + deltaOutput * deltaSmoothed;
+    const float target = parameters.getBool(Params::limiter) ? 1.0f : 0.0f;
+    float amount = limiterSmoothed;
+    for (int channel = 0; channel < numLimiterChannels; ++channel) {
+      auto *data = buffer.getWritePointer(channel);
+      const auto *limited = limiterBuffer.getReadPointer(channel);
+      amount = limiterSmoothed;
+      for (int sample = 0; sample < numSamples; ++sample) {
+        amount = moveTowards(amount, target);
+        data[sample] += (limited[sample] - data[sample]) * amount;
+      }
     }
+    limiterSmoothed = amount;
   }
+}
 
-  // Apply Output Gain before Limiter
-  buffer.applyGain(outputGain);
+void Vst_saturatorAudioProcessor::processSaturation(
+    juce::AudioBuffer<float> &buffer, const ChunkContext &context) {
+  auto &oversampling = *context.oversampling;
+  juce::dsp::AudioBlock<float> block =
+      juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(
+          0, (size_t)context.numChannels);
 
-  if (limiterEnable) {
-    juce::dsp::AudioBlock<float> block(buffer);
-    limiter.process(juce::dsp::ProcessContextReplacing<float>(block));
+  // Keep the last saturationHistoryLength input samples of the left
+  // channel, for leaveDualMono()
+  {
+    const auto *input = buffer.getReadPointer(0);
+    auto *history = saturationHistory.getWritePointer(0);
+    const int count = juce::jmin(context.numSamples, saturationHistoryLength);
+    for (int i = context.numSamples - count; i < context.numSamples; ++i) {
+      history[saturationHistoryPosition] = input[i];
+      saturationHistoryPosition =
+          (saturationHistoryPosition + 1) % saturationHistoryLength;
+    }
   }
 
-  analyzerTap.pushSamples(dryBuffer, buffer);
+  const int numChannels = context.numChannels;
+  std::array<juce::dsp::AudioBlock<float>, 2> oversampledBlocks;
+  {
+    const StageTimings::Scope timing(stageTimings, StageTimings::upsample);
+    for (int channel = 0; channel < numChannels; ++channel)
+      oversampledBlocks[(size_t)channel] =
+          oversampling.channels[(size_t)channel]->processSamplesUp(
+              block.getSingleChannelBlock((size_t)channel));
+  }
+  const int numOversampled = (int)oversampledBlocks[0].getNumSamples();
+  {
+    const StageTimings::Scope timing(stageTimings, StageTimings::shaper);
+
+    // While Drive moves, the driven signal is made here, at the oversampled
+    // rate, and the curves run with a drive of 1
+    const float drive = context.driveMoving ? 1.0f : context.drive;
+    if (context.driveMoving)
+      ramps[driveRamp].fill(driveRampBuffer.getWritePointer(0),
+                            numOversampled);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+      auto *data = oversampledBlocks[(size_t)channel].getChannelPointer(0);
+      if (context.driveMoving)
+        juce::FloatVectorOperations::multiply(
+            data, driveRampBuffer.getReadPointer(0), numOversampled);
+      shapeChannel(data, numOversampled, drive,
+                   adaaStates[(size_t)channel], context);
+    }
+    if (context.useTable)
+      waveshaperTable.endBlock(numOversampled);
+  }
 
-  // === ENVELOPE FOLLOWER UPDATE ===
-  // Calculate max peak of the output block to drive UI
-  float maxPeak = 0.0f;
-  for (int channel = 0; channel < totalNumOutputChannels; ++channel) {
-    maxPeak = juce::jmax(
-        maxPeak, buffer.getMagnitude(channel, 0, buffer.getNumSamples()));
+  const StageTimings::Scope timing(stageTimings, StageTimings::downsample);
+  for (int channel = 0; channel < numChannels; ++channel) {
+    auto channelBlock = block.getSingleChannelBlock((size_t)channel);
+    oversampling.channels[(size_t)channel]->processSamplesDown(channelBlock);
   }
+}
 
-  // Simple smoothing/decay could be done here, or just push peak to UI
-  // Pushing current peak is fine for "Is Talking" logic
-  // We use atomic store
-  currentRMSLevel.store(maxPeak, std::memory_order_relaxed);
+void Vst_saturatorAudioProcessor::shapeChannel(float *data, int numSamples,
+                                               float drive,
+                                               Adaa::ChannelState &adaaState,
+                                               const ChunkContext &context) {
+  if (context.adaaClosedForm) {
+    Adaa::processClosedForm(context.waveshapeIndex, data, numSamples, drive,
+                            context.shape, adaaState);
+  } else if (context.adaaMode && context.useTable) {
+    waveshaperTable.processChannelAdaa(data, numSamples, drive, adaaState);
+  } else if (context.useTable) {
+    waveshaperTable.processChannel(data, numSamples, drive);
+  } else {
+    // Keep the ADAA history current while falling back
+    if (numSamples > 0)
+      adaaState.previous = (double)data[numSamples - 1] * drive;
+    context.waveshapeKernel(data, numSamples, drive, context.shape);
+  }
+}
 
-  // CPU usage timing end
-  const auto cpuTimerEnd = juce::Time::getHighResolutionTicks();
-  const double elapsedSec = juce::Time::highResolutionTicksToSeconds(cpuTimerEnd - cpuTimerStart);
-  const double bufferDuration = static_cast<double>(buffer.getNumSamples()) / getSampleRate();
-  if (bufferDuration > 0.0) {
-    // Smooth the CPU reading (exponential moving average)
-    const double newCpu = elapsedSec / bufferDuration;
-    const double smoothing = 0.1; // lower = smoother
-    cpuUsage.store(cpuUsage.load(std::memory_order_relaxed) * (1.0 - smoothing) + newCpu * smoothing,
-                   std::memory_order_relaxed);
+void Vst_saturatorAudioProcessor::delayWet(juce::AudioBuffer<float> &buffer,
+                                           int numChannels, int numSamples) {
+  const int numWetChannels =
+      juce::jmin(numChannels, wetDelayLine.getNumChannels());
+  for (int channel = 0; channel < numWetChannels; ++channel) {
+    auto *data = buffer.getWritePointer(channel);
+    auto *line = wetDelayLine.getWritePointer(channel);
+    int writePosition = wetDelayWritePosition;
+    for (int i = 0; i < numSamples; ++i) {
+      line[writePosition] = data[i];
+      data[i] =
+          line[(writePosition - wetDelaySamples + maxDryDelay) % maxDryDelay];
+      writePosition = (writePosition + 1) % maxDryDelay;
+    }
+  }
+  wetDelayWritePosition = (wetDelayWritePosition + numSamples) % maxDryDelay;
+}
+
+void Vst_saturatorAudioProcessor::leaveDualMono(const ChunkContext &context) {
+  crossover.copyChannelState(0, 1);
+  if (wetDelayLine.getNumChannels() > 1)
+    wetDelayLine.copyFrom(1, 0, wetDelayLine, 0, 0, maxDryDelay);
+
+  // Replay the end of the saturation history through the right channel's
+  // oversampler and the chunk's curve, oldest sample first, in chunks of
+  // the prepared size: as many samples as its latency plus
+  // replaySettleSamples. The curve starts from the ADAA history the left
+  // channel had at that point.
+  auto &oversampling = *context.oversampling->channels[1];
+  const int replayLength = juce::jmin(
+      saturationHistoryLength - 1,
+      juce::roundToInt(oversampling.getLatencyInSamples()) +
+          replaySettleSamples);
+  const auto *history = saturationHistory.getReadPointer(0);
+  int position = (saturationHistoryPosition - replayLength +
+                  saturationHistoryLength) %
+                 saturationHistoryLength;
+  adaaStates[1].previous =
+      (double)history[(position - 1 + saturationHistoryLength) %
+                      saturationHistoryLength] *
+      context.drive;
+  for (int start = 0; start < replayLength;) {
+    const int count =
+        juce::jmin(replayBuffer.getNumSamples(), replayLength - start);
+    auto *replay = replayBuffer.getWritePointer(0);
+    for (int i = 0; i < count; ++i) {
+      replay[i] = history[position];
+      position = (position + 1) % saturationHistoryLength;
+    }
+
+    juce::dsp::AudioBlock<float> block =
+        juce::dsp::AudioBlock<float>(replayBuffer).getSubsetSampleBlock(
+            0, (size_t)count);
+    auto oversampledBlock = oversampling.processSamplesUp(block);
+    shapeChannel(oversampledBlock.getChannelPointer(0),
+                 (int)oversampledBlock.getNumSamples(), context.drive,
+                 adaaStates[1], context);
+    oversampling.processSamplesDown(block);
+    start += count;
+  }
+  adaaStates[1] = adaaStates[0];
+}
+
+void Vst_saturatorAudioProcessor::updateGovernor(double usage,
+                                                 double blockSeconds) {
+  // Offline renders have no deadline
+  if (!parameters.getBool(Params::governor) || isNonRealtime()) {
+    pendingGovernorLevel = 0;
+    governorOverSeconds = governorUnderSeconds = 0.0;
+    return;
+  }
+  // One step at a time, each once its oversampler runs
+  if (pendingGovernorLevel != governorLevel.load(std::memory_order_relaxed) ||
+      getWantedOversampling() != activeOversampling.load())
+    return;
+
+  const double budget = parameters.get(Params::cpuBudget) / 100.0;
+  governorOverSeconds =
+      usage > budget ? governorOverSeconds + blockSeconds : 0.0;
+  governorUnderSeconds = usage < budget * governorHysteresis
+                             ? governorUnderSeconds + blockSeconds
+                             : 0.0;
+
+  if (governorOverSeconds >= governorDownSeconds &&
+      pendingGovernorLevel < maxGovernorLevel) {
+    ++pendingGovernorLevel;
+    governorOverSeconds = governorUnderSeconds = 0.0;
+  } else if (governorUnderSeconds >= governorUpSeconds &&
+             pendingGovernorLevel > 0) {
+    --pendingGovernorLevel;
+    governorOverSeconds = governorUnderSeconds = 0.0;
   }
 }
 
+void Vst_saturatorAudioProcessor::setDryDelay(int samples) {
+  samples = juce::jlimit(0, maxDryDelay - 1, samples);
+  if (samples == dryDelaySamples)
+    return;
+  // Crossfade from the tap heard now (a fade in progress restarts from
+  // its newer tap)
+  previousDryDelaySamples = dryDelaySamples;
+  dryDelaySamples = samples;
+  dryDelayFade = 0.0f;
+}
+
+void Vst_saturatorAudioProcessor::resetProcessing() {
+  crossover.reset();
+  if (const int index = activeOversampling.load(); index >= 0)
+    if (auto &oversampler = oversamplers[(size_t)index])
+      oversampler->reset();
+  limiter.reset();
+  adaaStates = {};
+  wetDelayLine.clear();
+  saturationHistory.clear();
+}
+
+void Vst_saturatorAudioProcessor::wakeUp() {
+  // The filters have settled on the silent input (to within
+  // silenceThreshold) and still hold that state, so processing carries on
+  // from the held output without a step
+  suspended = false;
+}
+
 void Vst_saturatorAudioProcessor::setAnalyzerEnabled(bool shouldEnable) {
   analyzerTap.setEnabled(shouldEnable);
 }
 
 //==============================================================================
 // 3. Editor Creation
+// The bench tools build the processor without the editor
+// (STEVERATOR_HEADLESS), so they do not need the GUI modules.
 bool Vst_saturatorAudioProcessor::hasEditor() const {
-  return true; // (change this to false if you choose to not supply an editor)
+#if STEVERATOR_HEADLESS
+  return false;
+#else
+  return true;
+#endif
 }
 
 juce::AudioProcessorEditor *Vst_saturatorAudioProcessor::createEditor() {
+#if STEVERATOR_HEADLESS
+  return nullptr;
+#else
   return new Vst_saturatorAudioProcessorEditor(*this);
+#endif
 }
 
 //==============================================================================
@@ -18,12 +18,23 @@
 
 #pragma once
 
+#include "Adaa.h"
+#include "BlockRamp.h"
+#include "Crossover.h"
+#include "DeadlineMonitor.h"
+#include "ParameterSnapshot.h"
+#include "SimdWaveshapers.h"
+#include "StageTimings.h"
+#include "TraceRecorder.h"
 #include "VisualizerAnalysis.h"
+#include "WaveshaperTable.h"
 #include <JuceHeader.h>
 #include <juce_dsp/juce_dsp.h>
+#include <utility>
 
 //==============================================================================
-class Vst_saturatorAudioProcessor : public juce::AudioProcessor {
+class Vst_saturatorAudioProcessor : public juce::AudioProcessor,
+                                    private juce::Timer {
 public:
   //==============================================================================
   // Constructor & Destructor
@@ -85,6 +96,10 @@ public:
   AnalyzerTap analyzerTap;
   void setAnalyzerEnabled(bool shouldEnable);
 
+  // Timeline of processBlock(), the visualizer timer and the editor paint,
+  // started from DevTools (TraceRecorder.h)
+  TraceRecorder traceRecorder;
+
   // Envelope follower for UI reaction (Steve talking)
   std::atomic<float> currentRMSLevel{0.0f};
 
@@ -92,36 +107,361 @@ public:
   double getCpuUsage() const { return cpuUsage.load(std::memory_order_relaxed); }
   std::atomic<double> cpuUsage{0.0};
 
+  // Instruction set used by the waveshaper kernels (for DevTools)
+  const char *getWaveshaperIsaName() const {
+    return SimdWaveshapers::getIsaName(waveshaperIsa);
+  }
+
+  // Blocks processed as dual mono (identical left and right input, see
+  // processChunk()), for DevTools
+  juce::int64 getNumDualMonoBlocks() const {
+    return numDualMonoBlocks.load(std::memory_order_relaxed);
+  }
+
+  // Blocks skipped because the input was silent and the tails had decayed
+  // (see suspended), for DevTools
+  juce::int64 getNumSuspendedBlocks() const {
+    return numSuspendedBlocks.load(std::memory_order_relaxed);
+  }
+
+  // Oversampling factor currently in use (1, 2, 4, 8 or 16)
+  int getOversamplingFactor() const {
+    return 1 << (juce::jmax(0, activeOversampling.load()) %
+                 numOversamplingFactors);
+  }
+
+  // True when the factor in use was picked by "Auto" oversampling
+  bool isOversamplingAuto() const;
+
+  // CPU governor level (0 = full quality, see updateGovernor()), for
+  // DevTools
+  int getGovernorLevel() const {
+    return governorLevel.load(std::memory_order_relaxed);
+  }
+
+  // Per-stage timing (StageTimings.h), on while DevTools is open
+  void setStageTimingEnabled(bool shouldEnable) {
+    stageTimings.setEnabled(shouldEnable);
+  }
+  TimingHistogram::Snapshot getStageTiming(int stage) const {
+    return stageTimings.getSnapshot(stage);
+  }
+
+  // processBlock() durations against their deadline (DeadlineMonitor.h),
+  // for DevTools
+  const DeadlineMonitor &getDeadlineMonitor() const { return deadlineMonitor; }
+
 private:
   // Helper function to define the parameters layout
   juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+  // Parameter values, read once per block through cached handles
+  ParameterSnapshot parameters;
+
+  StageTimings stageTimings;
+  DeadlineMonitor deadlineMonitor;
+
+  // Values derived from the parameters, recomputed only when their inputs
+  // change (audio thread)
+  struct DerivedParameters {
+    float drive = 1.0f; // gain into the curve
+    float inputGain = 1.0f;
+    float outputGain = 1.0f;
+    float lowLevel = 1.0f;
+    float highLevel = 1.0f;
+    float mix = 1.0f; // 0..1
+    float deltaGain = 1.0f;
+  };
+  DerivedParameters derived;
+  void updateDerivedParameters();
+
+  // The gains of DerivedParameters glide to their new value over ~20 ms,
+  // one chunk at a time (see BlockRamp.h). The drive ramp is stretched to
+  // the oversampled rate in driveRampBuffer.
+  enum Ramp : int {
+    driveRamp,
+    inputGainRamp,
+    outputGainRamp,
+    lowLevelRamp,
+    highLevelRamp,
+    mixRamp,
+    deltaGainRamp,
+    numRamps
+  };
+  std::array<BlockRamp, numRamps> ramps;
+  juce::AudioBuffer<float> driveRampBuffer;
+
   // --- DSP Member Variables ---
 
-  // 3-Band Crossover using Linkwitz-Riley filters
-  using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-  Filter lp1, hp1, lp2, hp2; // Four filters for a 3-band split
+  // 3-Band Linkwitz-Riley crossover, with the band stages fused in
+  ThreeBandCrossover crossover;
+
+  // Dry copy of the input for the mix, sized in prepareToPlay()
+  juce::AudioBuffer<float> dryBuffer;
+
+  // processBlock() for at most preparedBlockSize samples
+  void processChunk(juce::AudioBuffer<float> &buffer);
+
+  struct Oversampler; // below
+
+  // Everything the pipeline stages need for one chunk
+  struct ChunkContext {
+    int numChannels = 0;
+    int numSamples = 0;
+    ThreeBandCrossover::BandSettings bands;
+
+    Oversampler *oversampling = nullptr;
+    Waveshapers::BlockKernel waveshapeKernel = nullptr;
+    int waveshapeIndex = 0;
+    float drive = 1.0f;
+    bool driveMoving = false; // drive is ramps[driveRamp] this chunk
+    float shape = 0.0f;
+    bool adaaMode = false;
+    bool adaaClosedForm = false;
+    bool useTable = false;
+
+    float mix = 1.0f;
+    float deltaGain = 1.0f;
+    float outputGain = 1.0f;
+    bool gainsMoving = false; // mix, delta or output gain ramps this chunk
+    float wetTarget = 1.0f;   // 0 while a routing or quality switch dips
+    FastMath::ScalarFunction tanh = nullptr;
+  };
+
+  // A routing stage that can be switched: off, on, or crossfading between
+  // the two
+  enum class StageState { Off, On, Fading };
 
-  // Audio buffers for split-band processing
-  juce::AudioBuffer<float> lowBuffer, midBuffer, highBuffer;
+  // One processing pipeline per routing combination (Pre/Post order, delta
+  // monitoring, limiter, and whether dry has to be mixed in), with the
+  // unused stages compiled out. processChunk() picks one per chunk.
+  template <bool post, StageState delta, StageState limiting, bool mixed>
+  void runPipeline(juce::AudioBuffer<float> &buffer,
+                   const ChunkContext &context);
+  using Pipeline = void (Vst_saturatorAudioProcessor::*)(
+      juce::AudioBuffer<float> &, const ChunkContext &);
+  static constexpr int numPipelines = 2 * 3 * 3 * 2;
+  template <size_t... indices>
+  static constexpr std::array<Pipeline, sizeof...(indices)>
+  makePipelines(std::index_sequence<indices...>);
 
-  // Previous parameter values to avoid unnecessary updates in the audio thread
-  float lastLowFreq = 0.0f;
-  float lastHighFreq = 0.0f;
-  double lastSampleRate = 0.0;
+  // Oversampled waveshaper (upsampling, curve, downsampling), in place
+  void processSaturation(juce::AudioBuffer<float> &buffer,
+                         const ChunkContext &context);
+  // The curve of the chunk (Direct, Table or ADAA) over one oversampled
+  // channel
+  void shapeChannel(float *data, int numSamples, float drive,
+                    Adaa::ChannelState &adaaState,
+                    const ChunkContext &context);
 
-  // Soft Limiter
+  // Dual mono: once the left and right inputs have been bit-identical for
+  // dualMonoHoldSeconds (long enough for the filter states of both
+  // channels to agree), only the left channel runs through the crossover,
+  // the oversampled shaper and the mix stage, and is copied to the right
+  // one. The limiter still runs on both: juce::dsp::Limiter keeps its
+  // state to itself and its release is too long to resynchronize.
+  static constexpr double dualMonoHoldSeconds = 0.1;
+  bool dualMono = false;
+  int identicalInputSamples = 0;
+  std::atomic<juce::int64> numDualMonoBlocks{0};
+
+  // When the channels differ again, the right channel gets the left one's
+  // filter state. The oversamplers keep theirs to themselves, so the right
+  // channel's oversampler and curve are fed the end of the left saturation
+  // input instead (output discarded; the left channel is not touched): the
+  // oversampler's latency plus replaySettleSamples, which covers the
+  // significant part of its filters' memory, so it ends up in the left
+  // one's state. That is a few dozen to a few hundred samples rather than
+  // the whole history, so the block that leaves dual mono does not spike.
+  static constexpr int saturationHistoryLength = 1024;
+  static constexpr int replaySettleSamples = 128;
+  juce::AudioBuffer<float> saturationHistory; // ring, 1 channel
+  int saturationHistoryPosition = 0;
+  juce::AudioBuffer<float> replayBuffer;
+  void leaveDualMono(const ChunkContext &context);
+
+  // Suspend mode: once every input sample has stayed below silenceThreshold
+  // (-120 dB) for getTailLengthSeconds() and the output of a block is
+  // constant to within it (silence, or a DC offset such as Wavelet's),
+  // processBlock() outputs that value (heldOutput) without processing. The
+  // filter states are settled and kept, so the first block with signal, or
+  // with a parameter change, picks up from them (wakeUp()).
+  static constexpr double silenceThreshold = 1.0e-6;
+  static constexpr double minLowFrequency = 20.0;  // "lowFreq" range start
+  static constexpr double limiterReleaseMs = 100.0;
+  bool suspended = false;
+  std::array<float, 2> heldOutput{};
+  juce::int64 silentInputSamples = 0;
+  std::atomic<juce::int64> numSuspendedBlocks{0};
+  void wakeUp();
+  // Clears the filter states of the wet path
+  void resetProcessing();
+
+  // Soft Limiter, and a copy of the block to crossfade it in and out
   juce::dsp::Limiter<float> limiter;
+  juce::AudioBuffer<float> limiterBuffer;
+
+  // Oversampling for non-aliased saturation, one oversampler per filter
+  // type and factor (index = filter * numOversamplingFactors + log2 of the
+  // factor; IIR or linear-phase FIR, 1x to 16x). They are created and
+  // prepared on the message thread the first time they are selected, then
+  // published through preparedOversampling; the audio thread only ever
+  // touches the published one. It switches to it once the wet part has
+  // dipped out, and keeps it out for oversamplingSettleSamples (the length
+  // of the new filters, which start from silence).
+  static constexpr int numOversamplingFactors = 5;
+  static constexpr int numOversamplingFilters = 2;
+
+  // One mono juce::dsp::Oversampling per channel: JUCE keeps the channel
+  // states to itself, and separate objects let leaveDualMono() bring the
+  // right channel up to date without touching the left one.
+  struct Oversampler {
+    Oversampler(int stages, juce::dsp::Oversampling<float>::FilterType type) {
+      // Integer latency, so the dry path can be delayed by a whole number
+      // of samples
+      for (auto &channel : channels)
+        channel = std::make_unique<juce::dsp::Oversampling<float>>(
+            1, (size_t)stages, type, true, true);
+    }
+
+    void initProcessing(size_t maximumBlockSize) {
+      for (auto &channel : channels)
+        channel->initProcessing(maximumBlockSize);
+    }
+    void reset() {
+      for (auto &channel : channels)
+        channel->reset();
+    }
+    float getLatencyInSamples() const {
+      return channels[0]->getLatencyInSamples();
+    }
+    size_t getOversamplingFactor() const {
+      return channels[0]->getOversamplingFactor();
+    }
+
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 2> channels;
+  };
+  std::array<std::unique_ptr<Oversampler>,
+             numOversamplingFactors * numOversamplingFilters>
+      oversamplers;
+  std::atomic<int> preparedOversampling{-1};
+  std::atomic<int> activeOversampling{-1}; // written by the audio thread
+  // What the audio thread wants (governed and reference index); a
+  // message-thread timer prepares it, so the audio thread only stores
+  std::atomic<int> requestedOversampling{-1}, requestedReference{-1};
+  int oversamplingSettleSamples = 0;
+  int preparedBlockSize = 0;
+
+  // The reported latency is that of the factor the CPU governor starts
+  // from (referenceOversampling), the largest it can reach, so the host
+  // never sees it change with the governor. Below that factor the wet part
+  // is delayed by the difference (wetDelaySamples).
+  std::atomic<int> referenceOversampling{-1};
+  std::atomic<int> preparedLatency{0};
+  int latencyInUse = 0; // audio thread
+
+  // "oversampling" (or "offlineOversampling" while rendering offline) and
+  // "oversamplingFilter", as an index into oversamplers, lowered by the
+  // CPU governor unless governed is false
+  int getWantedOversampling(bool governed = true) const;
+  // Message thread: creates the oversampler on first use
+  Oversampler &getOversampler(int index);
+
+  // "Auto" oversampling (the last "oversampling" choice): the factor that
+  // takes the sample rate to autoOversampledRate, doubled for wideband
+  // waveshapes (Waveshapers::isWideband()) and halved in ADAA mode. At
+  // 44.1 / 48 kHz that is 4x for smooth curves, at 96 kHz 2x, at 192 kHz
+  // 1x. Changing the waveshape can change the factor, and the latency.
+  static constexpr int autoOversampling = numOversamplingFactors;
+  static constexpr double autoOversampledRate = 170000.0;
+  int getAutoOversamplingStages() const;
+  // Message thread: prepares and publishes the wanted oversampler, reports
+  // the latency of the reference one
+  void updateOversampling();
+  void timerCallback() override;
 
-  // Oversampling for non-aliased saturation
-  juce::dsp::Oversampling<float> oversampling;
+  // Dry path delay, so that the dry/wet mix and the delta signal line up
+  // with the oversampled (delayed) wet signal
+  static constexpr int maxDryDelay = 1024;
+  juce::AudioBuffer<float> dryDelayLine;
+  int dryDelayWritePosition = 0;
+  int dryDelaySamples = 0; // audio thread
+  // A new length crossfades from the previous one over ~10 ms
+  // (routingCrossfadeStep), so it does not click
+  int previousDryDelaySamples = 0;
+  float dryDelayFade = 1.0f;
+  void setDryDelay(int samples);
+
+  // Wet path padding up to the reported latency (see
+  // referenceOversampling); it only changes while the wet part is out
+  juce::AudioBuffer<float> wetDelayLine;
+  int wetDelayWritePosition = 0;
+  int wetDelaySamples = 0;
+  void delayWet(juce::AudioBuffer<float> &buffer, int numChannels,
+                int numSamples);
+
+  // Waveshaper kernels for the widest instruction set this CPU supports
+  // (chosen once, when the plugin is loaded), one table per quality tier
+  const SimdWaveshapers::Isa waveshaperIsa = SimdWaveshapers::getBestIsa();
+  const std::array<const SimdWaveshapers::KernelTable *, FastMath::numTiers>
+      waveshaperKernels{
+          &SimdWaveshapers::getKernelTable(waveshaperIsa,
+                                           FastMath::Tier::Exact),
+          &SimdWaveshapers::getKernelTable(waveshaperIsa, FastMath::Tier::High),
+          &SimdWaveshapers::getKernelTable(waveshaperIsa, FastMath::Tier::Eco)};
+
+  // Lookup-table waveshaper ("shaperMode" = Table, and ADAA for the
+  // waveshapes without a closed-form antiderivative)
+  WaveshaperTable waveshaperTable;
+
+  // ADAA mode ("shaperMode" = ADAA) history, per channel
+  std::array<Adaa::ChannelState, 2> adaaStates;
 
   // Delta monitoring crossfade state (for anti-click transitions)
   float deltaSmoothed =
       0.0f; // Current smoothed delta state (0.0 = normal, 1.0 = delta mode)
 
-  // Delta crossfade parameters (calculated in prepareToPlay)
-  float deltaCrossfadeStep =
+  // Limiter crossfade (0.0 = bypassed, 1.0 = limiting)
+  float limiterSmoothed = 0.0f;
+
+  // Pre/Post switches go through the dry signal: the wet part fades out,
+  // the order changes, then it fades back in. activePrePost is the order
+  // in use, wetSmoothed the wet part (1.0 = normal).
+  bool activePrePost = false;
+  float wetSmoothed = 1.0f;
+
+  // Bypass outputs the dry signal through the dry delay, so the host's
+  // delay compensation holds, and crossfades to it over ~10 ms
+  // (bypassSmoothed, 1.0 = bypassed). While fully bypassed nothing else
+  // runs; coming back, the filters start from silence (resetProcessing())
+  // and the dry signal is held for bypassHoldSamples before fading out.
+  float bypassSmoothed = 0.0f;
+  bool bypassStale = false;
+  int bypassHoldSamples = 0;
+
+  // CPU governor ("governor", "cpuBudget"): when the smoothed cpuUsage stays
+  // above the budget for governorDownSeconds, the quality steps down one
+  // level: 1 = one oversampling stage less, 2 = also the next FastMath
+  // tier, 3 = also the lookup table for Direct waveshapes. Once it stays
+  // below governorHysteresis x budget for governorUpSeconds, it steps back
+  // up. A step dips the wet part like a Pre/Post switch and is applied
+  // once it is out; a new oversampling factor then keeps it out until the
+  // new oversampler runs. The reported latency stays that of level 0.
+  static constexpr int maxGovernorLevel = 3;
+  static constexpr double governorDownSeconds = 0.5;
+  static constexpr double governorUpSeconds = 5.0;
+  static constexpr double governorHysteresis = 0.7;
+  std::atomic<int> governorLevel{0}; // applied; getWantedOversampling()
+  int pendingGovernorLevel = 0;
+  double governorOverSeconds = 0.0, governorUnderSeconds = 0.0;
+  void updateGovernor(double usage, double blockSeconds);
+
+  // Start the next chunk with every crossfade at its target (after
+  // prepareToPlay())
+  bool snapCrossfades = true;
+
+  // Routing crossfade parameters (calculated in prepareToPlay)
+  float routingCrossfadeStep =
       0.0f; // Amount to change per sample (for ~10ms fade)
 
   //==============================================================================
@@ -0,0 +1,418 @@
+/*
+  ==============================================================================
+
+    SimdWaveshaperKernels.h
+    -----------------------
+    Vectorized versions of the curves in Waveshapers.cpp.
+
+    Role:
+    Everything in this file is a template over an "Ops" struct that wraps
+    the intrinsics of one instruction set (see FastMath.h for the interface)
+    and over the FastMath accuracy tier. Each SimdWaveshapers_*.cpp file
+    defines its own Ops in an anonymous namespace, is compiled with the
+    matching compiler flags, and calls fillKernels<Ops>(). Because the Ops
+    types have internal linkage, instantiations built with different flags
+    never collide at link time.
+
+    Like FastMathVec.h, this header includes nothing from JUCE or the
+    standard library (see there why): the kernels are handed out as a plain
+    array of function pointers, and SimdWaveshapers.cpp builds the tables.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FastMathVec.h"
+
+namespace SimdWaveshapers {
+
+// Same signature as Waveshapers::BlockKernel, indexed like the "waveshape"
+// parameter (numKernels == Waveshapers::numWaveshapes)
+using BlockKernel = void (*)(float *data, int numSamples, float drive,
+                             float shape);
+constexpr int numKernels = 58;
+
+namespace detail {
+// Defined in SimdWaveshapers.cpp (SSE2, NEON) and in the per-ISA
+// translation units (AVX2, AVX-512). Each overwrites the kernels of the
+// vectorized curves for one tier, and returns false when the file was
+// compiled without support for that instruction set.
+bool fillSse2Kernels(FastMath::Tier tier, BlockKernel *kernels);
+bool fillAvx2Kernels(FastMath::Tier tier, BlockKernel *kernels);
+bool fillAvx512Kernels(FastMath::Tier tier, BlockKernel *kernels);
+bool fillNeonKernels(FastMath::Tier tier, BlockKernel *kernels);
+} // namespace detail
+
+//==============================================================================
+// The curves. Each one mirrors the scalar curve with the same name in
+// Waveshapers.cpp (x is already driven, s is the "shape" parameter).
+namespace curves {
+using namespace FastMath;
+
+// === CLASSIC (0-9) ===
+template <typename F> F tube(F x, F s) {
+  const F soft = tanh(x * (1.0f - s * 0.5f));
+  const F hard = x - x * x * x / 3.0f;
+  return soft * (1.0f - s) + hard * s;
+}
+template <typename F> F softClip(F x, F s) { return tanh(x * (1.0f + s * 2.0f)); }
+template <typename F> F hardClip(F x, F s) {
+  return clamp(x * (1.0f + s * 3.0f), -1.0f, 1.0f);
+}
+template <typename F> F diode1(F x, F s) {
+  return select(x > 0.0f, tanh(x * (1.0f + s)), x * 0.5f);
+}
+template <typename F> F diode2(F x, F s) {
+  return select(x > 0.0f, x * 0.7f, tanh(x * (1.0f + s * 2.0f)));
+}
+template <typename F> F linearFold(F x, F s) {
+  const F threshold = 1.0f - s * 0.5f;
+  const F ax = abs(x);
+  return clamp(select(ax > threshold, threshold - (ax - threshold), x), -1.0f,
+               1.0f);
+}
+template <typename F> F sinFold(F x, F s) {
+  return sin(x * pi * (1.0f + s * 2.0f));
+}
+template <typename F> F zeroSquare(F x, F s) {
+  return x * x * sign(x) * (1.0f + s);
+}
+template <typename F> F downsample(F x, F s) { return tanh(x * (1.0f + s)); }
+template <typename F> F asym(F x, F s) {
+  return select(x > 0.0f, tanh(x * (1.0f + s * 2.0f)), x * 0.3f);
+}
+
+// === SHAPERS (10-19) ===
+template <typename F> F rectify(F x, F s) { return abs(x) * (1.0f - s * 0.5f); }
+template <typename F> F xShaper(F x, F s) {
+  return x * (1.0f + s) / (1.0f + s * abs(x));
+}
+template <typename F> F xShaperAsym(F x, F s) {
+  return select(x > 0.0f, x * (1.0f + s * 2.0f) / (1.0f + s * abs(x)),
+                x * 0.5f);
+}
+template <typename F> F sineShaper(F x, F s) {
+  return sin(tanh(x) * pi * 0.5f * (1.0f + s));
+}
+template <typename F> F stompBox(F x, F s) {
+  return atan(x * (1.0f + s * 5.0f)) / pi;
+}
+template <typename F> F tapeSat(F x, F s) {
+  return x * (1.0f - s) + tanh(x * 1.5f) * s;
+}
+template <typename F> F overdrive(F x, F s) {
+  return (2.0f / pi) * atan(x * (1.0f + s * 10.0f));
+}
+template <typename F> F softSat(F x, F s) { return x / (1.0f + abs(x) * s); }
+template <typename F> F bitCrush(F x, F s) {
+  // std::round() rounds halfway cases away from zero
+  const F levels = 2.0f + (1.0f - s) * 30.0f;
+  const F scaled = x * levels;
+  return copySign(floor(abs(scaled) + 0.5f), scaled) / levels;
+}
+template <typename F> F glitchFold(F x, F s) { return x * sin(x * s * pi); }
+
+// === ANALOG (20-27) ===
+template <typename F> F valve(F x, F s) {
+  const F biased = x + s * 0.2f;
+  return biased / (1.0f + abs(biased));
+}
+template <typename F> F fuzzFac(F x, F s) {
+  return sign(x) * (1.0f - exp(-abs(x * (1.0f + s * 10.0f))));
+}
+template <typename F> F cheby3(F x, F s) {
+  const F xl = clamp(x, -1.0f, 1.0f);
+  return (4.0f * xl * xl * xl - 3.0f * xl) * (0.5f + s * 0.5f);
+}
+template <typename F> F cheby5(F x, F s) {
+  const F xl = clamp(x, -1.0f, 1.0f);
+  const F x2 = xl * xl;
+  const F x3 = x2 * xl;
+  return (16.0f * (x3 * x2) - 20.0f * x3 + 5.0f * xl) * (0.5f + s * 0.5f);
+}
+template <typename F> F logSat(F x, F s) {
+  return sign(x) * log(1.0f + (10.0f + s * 50.0f) * abs(x)) /
+         log(11.0f + s * 50.0f);
+}
+template <typename F> F halfWave(F x, F s) {
+  return select(x > 0.0f, tanh(x * (1.0f + s)), x);
+}
+template <typename F> F cubic(F x, F s) {
+  const F xs = x * (1.0f + s);
+  return xs - (1.0f / 3.0f) * xs * xs * xs;
+}
+template <typename F> F octaverSat(F x, F s) {
+  return (abs(x) * 2.0f - 1.0f) * (0.5f + s * 0.5f);
+}
+
+// === TUBE TYPES (28-33) ===
+template <typename F> F triode(F x, F s) {
+  const F kp = 1.2f + s * 0.8f;
+  const F vg = x * (1.0f + s);
+  return select(vg > 0.0f, tanh(vg / kp) * kp, vg / (1.0f + abs(vg)));
+}
+template <typename F> F pentode(F x, F s) {
+  const F screen = 0.7f + s * 0.3f;
+  const F plate = x * (1.5f + s);
+  return tanh(plate * screen) + 0.1f * sin(plate * 3.0f) * s;
+}
+template <typename F> F classA(F x, F s) {
+  const F bias = s * 0.3f;
+  return tanh((x + bias) * (1.0f + s)) - bias * 0.5f;
+}
+template <typename F> F classAB(F x, F s) {
+  const F threshold = 0.3f - s * 0.2f;
+  const F ax = abs(x);
+  return select(ax < threshold, x * (1.0f + s * 2.0f),
+                sign(x) * (threshold +
+                           tanh((ax - threshold) * (2.0f + s * 3.0f))));
+}
+template <typename F> F classB(F x, F s) {
+  const F deadzone = 0.05f + s * 0.1f;
+  const F ax = abs(x);
+  return select(ax < deadzone, F::of(0.0f),
+                sign(x) * tanh((ax - deadzone) * (1.0f + s * 3.0f)));
+}
+template <typename F> F germanium(F x, F s) {
+  const F temp = 0.8f + s * 0.4f;
+  const F biased = x + s * 0.1f;
+  return sign(biased) * (1.0f - exp(-abs(biased) * temp * 5.0f)) *
+         (0.9f + s * 0.1f);
+}
+
+// === TAPE MODES (34-38) ===
+template <typename F> F tape15ips(F x, F s) {
+  const F headroom = 1.2f - s * 0.3f;
+  return tanh(x / headroom) * headroom + 0.05f * x * s;
+}
+template <typename F> F tape7ips(F x, F s) {
+  const F satPoint = 0.6f + s * 0.3f;
+  const F warmth = x + 0.15f * x * x * sign(x);
+  return tanh(warmth / satPoint) * satPoint;
+}
+template <typename F> F tapeCassette(F x, F s) {
+  const F hfLoss = 1.0f - s * 0.4f;
+  return tanh(x * (1.0f + s * 2.0f)) * hfLoss + x * (1.0f - hfLoss) * 0.5f;
+}
+template <typename F> F tape456(F x, F s) {
+  const F hysteresis = x + 0.2f * x * abs(x) * s;
+  return tanh(hysteresis * (1.0f + s * 0.5f));
+}
+template <typename F> F tapeSM900(F x, F s) {
+  const F modern = tanh(x * 1.1f);
+  const F vintage = x / (1.0f + abs(x) * 0.5f);
+  return modern * (1.0f - s) + vintage * s;
+}
+
+// === TRANSFORMER (39-42) ===
+template <typename F> F transformer(F x, F s) {
+  const F iron = x + 0.3f * sin(x * 2.0f) * s;
+  return tanh(iron * (1.0f + s));
+}
+template <typename F> F console(F x, F s) {
+  const F harmonic2 = 0.1f * x * abs(x) * s;
+  const F harmonic3 = 0.05f * x * x * x * s;
+  return tanh(x + harmonic2 + harmonic3);
+}
+template <typename F> F apiStyle(F x, F s) {
+  const F punch = x * (1.0f + s * 0.5f);
+  const F clipped = clamp(punch * 1.5f, -1.0f, 1.0f);
+  return tanh(punch * (1.0f - s * 0.5f) + clipped * s * 0.5f);
+}
+template <typename F> F sslStyle(F x, F s) {
+  return x / (1.0f + abs(x) * s * 0.5f) + 0.05f * x * x * x * s;
+}
+
+// === TRANSISTOR (43-47) ===
+template <typename F> F silicon(F x, F s) {
+  const F gain = 1.0f + s * 3.0f;
+  const F clipPoint = 0.8f - s * 0.2f;
+  const F clipped = min(max(x * gain, -clipPoint), clipPoint);
+  return tanh(clipped / clipPoint) * clipPoint;
+}
+template <typename F> F fetClean(F x, F s) {
+  const F ratio = 4.0f + s * 16.0f;
+  const F ax = abs(x);
+  return select(ax > 0.5f, sign(x) * (0.5f + (ax - 0.5f) / ratio), x);
+}
+template <typename F> F fetDirty(F x, F s) {
+  return tanh(x * (2.0f + s * 4.0f)) * (0.8f + s * 0.2f) +
+         0.1f * sin(x * 5.0f) * s;
+}
+template <typename F> F opAmp(F x, F s) {
+  const F gain = 1.0f + s * 10.0f;
+  const F clipped = clamp(x * gain, -1.0f, 1.0f);
+  return clipped * (1.0f - s * 0.3f) + tanh(x * gain) * s * 0.3f;
+}
+template <typename F> F cmos(F x, F s) {
+  const F digital = sign(x) * sqrt(abs(x));
+  return digital * s + tanh(x * (1.0f + s)) * (1.0f - s);
+}
+
+// === CREATIVE (48-52) ===
+template <typename F> F scream(F x, F s) {
+  const F driven = x * (3.0f + s * 7.0f);
+  return clamp(tanh(driven) + 0.2f * sin(driven * 3.0f) * s, -1.0f, 1.0f);
+}
+template <typename F> F buzz(F x, F s) {
+  const F buzzed = x + 0.3f * sin(x * 10.0f * (1.0f + s * 5.0f));
+  return tanh(buzzed * (1.0f + s));
+}
+template <typename F> F wrap(F x, F s) {
+  // std::fmod(a, 2) == a - 2 * trunc(a / 2)
+  const F a = x * (1.0f + s * 3.0f) + 3.0f;
+  const F half = a * 0.5f;
+  const F truncated = copySign(floor(abs(half)), half);
+  return a - truncated * 2.0f - 1.0f;
+}
+template <typename F> F density(F x, F s) {
+  return (tanh(x * 2.0f) + tanh(x * 0.5f)) * 0.5f * (1.0f + s * 0.5f);
+}
+
+// === MATH/EXOTIC (53-57) ===
+template <typename F> F cheby7(F x, F s) {
+  const F xl = clamp(x, -1.0f, 1.0f);
+  const F x2 = xl * xl;
+  const F x3 = x2 * xl;
+  const F x5 = x3 * x2;
+  const F x7 = x5 * x2;
+  return (64.0f * x7 - 112.0f * x5 + 56.0f * x3 - 7.0f * xl) *
+         (0.3f + s * 0.7f);
+}
+template <typename F> F hyperbolic(F x, F s) {
+  // sinh(a) / cosh(2a) == sign(a) * (u - u^3) / (1 + u^4) with u = e^-|a|,
+  // which cannot overflow for large inputs.
+  const F a = x * (0.5f + s * 1.5f);
+  const F u = exp(-abs(a));
+  const F u2 = u * u;
+  return copySign(u * (1.0f - u2) / (1.0f + u2 * u2), a);
+}
+template <typename F> F exponential(F x, F s) {
+  return sign(x) * (1.0f - exp(-abs(x) * (2.0f + s * 4.0f)));
+}
+template <typename F> F parabolic(F x, F s) {
+  const F scaled = x * (1.0f + s * 2.0f);
+  return select(abs(scaled) < 1.0f, scaled - scaled * scaled * scaled / 3.0f,
+                sign(scaled) * (2.0f / 3.0f));
+}
+template <typename F> F wavelet(F x, F s) {
+  const F t = x * (2.0f + s * 4.0f);
+  const F t2 = t * t;
+  return (1.0f - t2) * exp(-t2 * 0.5f) * (1.0f + s);
+}
+} // namespace curves
+
+//==============================================================================
+// Runs a vector curve over a whole channel. The remainder that does not fill
+// a register goes through a padded copy, so every sample uses the same math
+// (copied by hand: see the note at the top about the standard library).
+template <typename Ops, FastMath::Tier T,
+          FastMath::Vec<Ops, T> (*Curve)(FastMath::Vec<Ops, T>,
+                                         FastMath::Vec<Ops, T>)>
+void runVectorKernel(float *data, int numSamples, float drive, float shape) {
+  using F = FastMath::Vec<Ops, T>;
+  const F d = F::of(drive);
+  const F s = F::of(shape);
+
+  int i = 0;
+  for (; i + Ops::width <= numSamples; i += Ops::width)
+    Ops::store(data + i, Curve(F{Ops::load(data + i)} * d, s).v);
+
+  if (i < numSamples) {
+    float tail[Ops::width] = {};
+    for (int j = 0; j < numSamples - i; ++j)
+      tail[j] = data[i + j];
+    Ops::store(tail, Curve(F{Ops::load(tail)} * d, s).v);
+    for (int j = 0; j < numSamples - i; ++j)
+      data[i + j] = tail[j];
+  }
+}
+
+// Overwrites the kernels of the vectorized curves for one instruction set
+// and accuracy tier. Crackle calls rand() per sample, so it keeps its scalar
+// kernel.
+template <typename Ops, FastMath::Tier T>
+void fillKernels(BlockKernel *kernels) {
+  using F = FastMath::Vec<Ops, T>;
+  auto set = [kernels](int index, BlockKernel kernel) {
+    kernels[index] = kernel;
+  };
+
+  using namespace curves;
+  set(0, &runVectorKernel<Ops, T, &tube<F>>);
+  set(1, &runVectorKernel<Ops, T, &softClip<F>>);
+  set(2, &runVectorKernel<Ops, T, &hardClip<F>>);
+  set(3, &runVectorKernel<Ops, T, &diode1<F>>);
+  set(4, &runVectorKernel<Ops, T, &diode2<F>>);
+  set(5, &runVectorKernel<Ops, T, &linearFold<F>>);
+  set(6, &runVectorKernel<Ops, T, &sinFold<F>>);
+  set(7, &runVectorKernel<Ops, T, &zeroSquare<F>>);
+  set(8, &runVectorKernel<Ops, T, &downsample<F>>);
+  set(9, &runVectorKernel<Ops, T, &asym<F>>);
+  set(10, &runVectorKernel<Ops, T, &rectify<F>>);
+  set(11, &runVectorKernel<Ops, T, &xShaper<F>>);
+  set(12, &runVectorKernel<Ops, T, &xShaperAsym<F>>);
+  set(13, &runVectorKernel<Ops, T, &sineShaper<F>>);
+  set(14, &runVectorKernel<Ops, T, &stompBox<F>>);
+  set(15, &runVectorKernel<Ops, T, &tapeSat<F>>);
+  set(16, &runVectorKernel<Ops, T, &overdrive<F>>);
+  set(17, &runVectorKernel<Ops, T, &softSat<F>>);
+  set(18, &runVectorKernel<Ops, T, &bitCrush<F>>);
+  set(19, &runVectorKernel<Ops, T, &glitchFold<F>>);
+  set(20, &runVectorKernel<Ops, T, &valve<F>>);
+  set(21, &runVectorKernel<Ops, T, &fuzzFac<F>>);
+  set(22, &runVectorKernel<Ops, T, &cheby3<F>>);
+  set(23, &runVectorKernel<Ops, T, &cheby5<F>>);
+  set(24, &runVectorKernel<Ops, T, &logSat<F>>);
+  set(25, &runVectorKernel<Ops, T, &halfWave<F>>);
+  set(26, &runVectorKernel<Ops, T, &cubic<F>>);
+  set(27, &runVectorKernel<Ops, T, &octaverSat<F>>);
+  set(28, &runVectorKernel<Ops, T, &triode<F>>);
+  set(29, &runVectorKernel<Ops, T, &pentode<F>>);
+  set(30, &runVectorKernel<Ops, T, &classA<F>>);
+  set(31, &runVectorKernel<Ops, T, &classAB<F>>);
+  set(32, &runVectorKernel<Ops, T, &classB<F>>);
+  set(33, &runVectorKernel<Ops, T, &germanium<F>>);
+  set(34, &runVectorKernel<Ops, T, &tape15ips<F>>);
+  set(35, &runVectorKernel<Ops, T, &tape7ips<F>>);
+  set(36, &runVectorKernel<Ops, T, &tapeCassette<F>>);
+  set(37, &runVectorKernel<Ops, T, &tape456<F>>);
+  set(38, &runVectorKernel<Ops, T, &tapeSM900<F>>);
+  set(39, &runVectorKernel<Ops, T, &transformer<F>>);
+  set(40, &runVectorKernel<Ops, T, &console<F>>);
+  set(41, &runVectorKernel<Ops, T, &apiStyle<F>>);
+  set(42, &runVectorKernel<Ops, T, &sslStyle<F>>);
+  set(43, &runVectorKernel<Ops, T, &silicon<F>>);
+  set(44, &runVectorKernel<Ops, T, &fetClean<F>>);
+  set(45, &runVectorKernel<Ops, T, &fetDirty<F>>);
+  set(46, &runVectorKernel<Ops, T, &opAmp<F>>);
+  set(47, &runVectorKernel<Ops, T, &cmos<F>>);
+  set(48, &runVectorKernel<Ops, T, &scream<F>>);
+  set(49, &runVectorKernel<Ops, T, &buzz<F>>);
+  set(51, &runVectorKernel<Ops, T, &wrap<F>>);
+  set(52, &runVectorKernel<Ops, T, &density<F>>);
+  set(53, &runVectorKernel<Ops, T, &cheby7<F>>);
+  set(54, &runVectorKernel<Ops, T, &hyperbolic<F>>);
+  set(55, &runVectorKernel<Ops, T, &exponential<F>>);
+  set(56, &runVectorKernel<Ops, T, &parabolic<F>>);
+  set(57, &runVectorKernel<Ops, T, &wavelet<F>>);
+}
+
+// The same, with the tier picked at run time
+template <typename Ops>
+void fillKernels(FastMath::Tier tier, BlockKernel *kernels) {
+  switch (tier) {
+  case FastMath::Tier::Exact:
+    fillKernels<Ops, FastMath::Tier::Exact>(kernels);
+    break;
+  case FastMath::Tier::High:
+    fillKernels<Ops, FastMath::Tier::High>(kernels);
+    break;
+  case FastMath::Tier::Eco:
+    fillKernels<Ops, FastMath::Tier::Eco>(kernels);
+    break;
+  }
+}
+
+} // namespace SimdWaveshapers
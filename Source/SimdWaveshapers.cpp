@@ -0,0 +1,368 @@
+/*
+  ==============================================================================
+
+    SimdWaveshapers.cpp
+    -------------------
+    Instruction set dispatch for the SIMD waveshaper engine.
+
+    Role:
+    Holds the baseline kernels that need no extra compiler flags (SSE2 on
+    x86-64, NEON on arm64), picks the widest instruction set available at
+    runtime and produces the throughput report used by steverator_bench.
+    AVX2 and AVX-512 kernels live in SimdWaveshapers_AVX2.cpp and
+    SimdWaveshapers_AVX512.cpp, which CMake compiles with their own flags.
+
+  ==============================================================================
+*/
+
+#include "SimdWaveshapers.h"
+#include "SimdWaveshaperKernels.h"
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STEVERATOR_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define STEVERATOR_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace SimdWaveshapers {
+
+namespace {
+
+#if STEVERATOR_HAS_SSE2
+struct Sse2Ops {
+  using Reg = __m128;
+  using Mask = __m128;
+  static constexpr int width = 4;
+
+  static Reg broadcast(float x) { return _mm_set1_ps(x); }
+  static Reg load(const float *p) { return _mm_loadu_ps(p); }
+  static void store(float *p, Reg v) { _mm_storeu_ps(p, v); }
+
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+  static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+  static Reg mulAdd(Reg a, Reg b, Reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+  static Reg min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+  static Reg abs(Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  static Reg sqrt(Reg a) { return _mm_sqrt_ps(a); }
+
+  static Mask cmpGt(Reg a, Reg b) { return _mm_cmpgt_ps(a, b); }
+  static Mask cmpLt(Reg a, Reg b) { return _mm_cmplt_ps(a, b); }
+  static Reg select(Mask m, Reg a, Reg b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+  }
+
+  static Reg signBits(Reg a) { return _mm_and_ps(a, _mm_set1_ps(-0.0f)); }
+  static Reg orBits(Reg a, Reg b) { return _mm_or_ps(a, b); }
+  static Reg xorBits(Reg a, Reg b) { return _mm_xor_ps(a, b); }
+
+  static Reg roundNearest(Reg a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+  static Reg exp2Int(Reg n) {
+    const __m128i biased =
+        _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+    return _mm_castsi128_ps(_mm_slli_epi32(biased, 23));
+  }
+  static Reg frexp(Reg x, Reg &exponent) {
+    const __m128i bits = _mm_castps_si128(x);
+    const __m128i e = _mm_sub_epi32(
+        _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff)),
+        _mm_set1_epi32(126));
+    exponent = _mm_cvtepi32_ps(e);
+    const __m128i mantissa =
+        _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x807fffff)),
+                     _mm_set1_epi32(0x3f000000));
+    return _mm_castsi128_ps(mantissa);
+  }
+};
+#endif
+
+#if STEVERATOR_HAS_NEON
+struct NeonOps {
+  using Reg = float32x4_t;
+  using Mask = uint32x4_t;
+  static constexpr int width = 4;
+
+  static Reg broadcast(float x) { return vdupq_n_f32(x); }
+  static Reg load(const float *p) { return vld1q_f32(p); }
+  static void store(float *p, Reg v) { vst1q_f32(p, v); }
+
+  static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+  static Reg sub(Reg a, Reg b) { return vsubq_f32(a, b); }
+  static Reg mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+  static Reg div(Reg a, Reg b) { return vdivq_f32(a, b); }
+  static Reg mulAdd(Reg a, Reg b, Reg c) { return vfmaq_f32(c, a, b); }
+  static Reg min(Reg a, Reg b) { return vminq_f32(a, b); }
+  static Reg max(Reg a, Reg b) { return vmaxq_f32(a, b); }
+  static Reg abs(Reg a) { return vabsq_f32(a); }
+  static Reg sqrt(Reg a) { return vsqrtq_f32(a); }
+
+  static Mask cmpGt(Reg a, Reg b) { return vcgtq_f32(a, b); }
+  static Mask cmpLt(Reg a, Reg b) { return vcltq_f32(a, b); }
+  static Reg select(Mask m, Reg a, Reg b) { return vbslq_f32(m, a, b); }
+
+  static Reg signBits(Reg a) {
+    return vreinterpretq_f32_u32(
+        vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x80000000u)));
+  }
+  static Reg orBits(Reg a, Reg b) {
+    return vreinterpretq_f32_u32(
+        vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+  }
+  static Reg xorBits(Reg a, Reg b) {
+    return vreinterpretq_f32_u32(
+        veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+  }
+
+  static Reg roundNearest(Reg a) { return vcvtq_f32_s32(vcvtnq_s32_f32(a)); }
+  static Reg exp2Int(Reg n) {
+    const int32x4_t biased = vaddq_s32(vcvtnq_s32_f32(n), vdupq_n_s32(127));
+    return vreinterpretq_f32_s32(vshlq_n_s32(biased, 23));
+  }
+  static Reg frexp(Reg x, Reg &exponent) {
+    const uint32x4_t bits = vreinterpretq_u32_f32(x);
+    const int32x4_t e = vsubq_s32(
+        vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(bits, 23), vdupq_n_u32(0xff))),
+        vdupq_n_s32(126));
+    exponent = vcvtq_f32_s32(e);
+    const uint32x4_t mantissa = vorrq_u32(
+        vandq_u32(bits, vdupq_n_u32(0x807fffffu)), vdupq_n_u32(0x3f000000u));
+    return vreinterpretq_f32_u32(mantissa);
+  }
+};
+#endif
+
+static_assert(std::is_same_v<BlockKernel, Waveshapers::BlockKernel> &&
+                  numKernels == Waveshapers::numWaveshapes,
+              "SimdWaveshaperKernels.h must match Waveshapers.h");
+
+using FillFunction = bool (*)(FastMath::Tier, BlockKernel *);
+
+// The original std:: kernels
+KernelTable makeScalarKernelTable() {
+  KernelTable table{};
+  for (int i = 0; i < Waveshapers::numWaveshapes; ++i)
+    table[static_cast<size_t>(i)] = Waveshapers::getBlockKernel(i);
+  return table;
+}
+
+// One table per tier (indexed by FastMath::Tier): the scalar kernels with
+// the vectorized curves of one instruction set on top. Empty if that set
+// was not compiled in.
+struct CompiledTables {
+  bool compiled = false;
+  std::array<KernelTable, FastMath::numTiers> tables;
+};
+
+CompiledTables makeCompiledTables(FillFunction fill) {
+  CompiledTables compiled;
+  for (int tier = 0; tier < FastMath::numTiers; ++tier) {
+    auto &table = compiled.tables[static_cast<size_t>(tier)];
+    table = makeScalarKernelTable();
+    if (!fill(static_cast<FastMath::Tier>(tier), table.data()))
+      return {};
+  }
+  compiled.compiled = true;
+  return compiled;
+}
+
+// High and Eco evaluated one sample at a time
+bool fillScalarKernels(FastMath::Tier tier, BlockKernel *kernels) {
+  if (tier != FastMath::Tier::Exact)
+    fillKernels<FastMath::ScalarOps>(tier, kernels);
+  return true;
+}
+
+// Exact uses the original std:: kernels, High and Eco the approximations
+// evaluated one sample at a time.
+const KernelTable &getScalarKernelTable(FastMath::Tier tier) {
+  static const auto scalar = makeCompiledTables(&fillScalarKernels);
+  return scalar.tables[static_cast<size_t>(tier)];
+}
+
+const KernelTable *getCompiledKernelTable(Isa isa, FastMath::Tier tier) {
+  const auto find = [tier](const CompiledTables &compiled) {
+    return compiled.compiled ? &compiled.tables[static_cast<size_t>(tier)]
+                             : nullptr;
+  };
+
+  switch (isa) {
+  case Isa::Scalar:
+    return &getScalarKernelTable(tier);
+  case Isa::SSE2: {
+    static const auto sse2 = makeCompiledTables(&detail::fillSse2Kernels);
+    return find(sse2);
+  }
+  case Isa::AVX2: {
+    static const auto avx2 = makeCompiledTables(&detail::fillAvx2Kernels);
+    return find(avx2);
+  }
+  case Isa::AVX512: {
+    static const auto avx512 = makeCompiledTables(&detail::fillAvx512Kernels);
+    return find(avx512);
+  }
+  case Isa::NEON: {
+    static const auto neon = makeCompiledTables(&detail::fillNeonKernels);
+    return find(neon);
+  }
+  }
+  return nullptr;
+}
+
+bool cpuSupports(Isa isa) {
+  switch (isa) {
+  case Isa::Scalar:
+    return true;
+  case Isa::SSE2:
+    return juce::SystemStats::hasSSE2();
+  case Isa::AVX2:
+    return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+  case Isa::AVX512:
+    return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasFMA3();
+  case Isa::NEON:
+    return juce::SystemStats::hasNeon();
+  }
+  return false;
+}
+
+} // namespace
+
+namespace detail {
+bool fillSse2Kernels(FastMath::Tier tier, BlockKernel *kernels) {
+#if STEVERATOR_HAS_SSE2
+  fillKernels<Sse2Ops>(tier, kernels);
+  return true;
+#else
+  juce::ignoreUnused(tier, kernels);
+  return false;
+#endif
+}
+
+bool fillNeonKernels(FastMath::Tier tier, BlockKernel *kernels) {
+#if STEVERATOR_HAS_NEON
+  fillKernels<NeonOps>(tier, kernels);
+  return true;
+#else
+  juce::ignoreUnused(tier, kernels);
+  return false;
+#endif
+}
+} // namespace detail
+
+bool isIsaAvailable(Isa isa) {
+  return cpuSupports(isa) &&
+         getCompiledKernelTable(isa, FastMath::Tier::Exact) != nullptr;
+}
+
+Isa getBestIsa() {
+  static const Isa best = [] {
+    for (auto isa : {Isa::AVX512, Isa::AVX2, Isa::NEON, Isa::SSE2})
+      if (isIsaAvailable(isa))
+        return isa;
+    return Isa::Scalar;
+  }();
+  return best;
+}
+
+const char *getIsaName(Isa isa) {
+  switch (isa) {
+  case Isa::Scalar:
+    return "Scalar";
+  case Isa::SSE2:
+    return "SSE2";
+  case Isa::AVX2:
+    return "AVX2";
+  case Isa::AVX512:
+    return "AVX-512";
+  case Isa::NEON:
+    return "NEON";
+  }
+  return "Unknown";
+}
+
+const KernelTable &getKernelTable(Isa isa, FastMath::Tier tier) {
+  if (isIsaAvailable(isa))
+    return *getCompiledKernelTable(isa, tier);
+  return getScalarKernelTable(tier);
+}
+
+juce::String createThroughputReport(FastMath::Tier tier, int numSamples,
+                                    int numRepeats) {
+  numSamples = juce::jmax(1, numSamples);
+  numRepeats = juce::jmax(1, numRepeats);
+
+  juce::Array<Isa> isas;
+  for (auto isa : {Isa::Scalar, Isa::SSE2, Isa::NEON, Isa::AVX2, Isa::AVX512})
+    if (isIsaAvailable(isa))
+      isas.add(isa);
+
+  // Same pseudo-random input for every kernel, roughly what the oversampled
+  // signal looks like after a healthy amount of drive.
+  juce::Random random(0x5eed);
+  juce::HeapBlock<float> source(numSamples), work(numSamples);
+  for (int i = 0; i < numSamples; ++i)
+    source[i] = random.nextFloat() * 4.0f - 2.0f;
+
+  const double ticksPerSecond =
+      (double)juce::Time::getHighResolutionTicksPerSecond();
+
+  auto measure = [&](Waveshapers::BlockKernel kernel) {
+    juce::int64 ticks = 0;
+    for (int r = 0; r < numRepeats; ++r) {
+      std::copy(source.get(), source.get() + numSamples, work.get());
+      const auto start = juce::Time::getHighResolutionTicks();
+      kernel(work.get(), numSamples, 1.5f, 0.5f);
+      ticks += juce::Time::getHighResolutionTicks() - start;
+    }
+    const double seconds = juce::jmax(1.0e-9, (double)ticks / ticksPerSecond);
+    return (double)numSamples * numRepeats / seconds / 1.0e6;
+  };
+
+  juce::String report;
+  report << "Waveshaper throughput, " << FastMath::getTierName(tier)
+         << " tier (Msamples/s, " << numSamples << " samples x " << numRepeats
+         << " runs)\n";
+  report << "Best instruction set: " << getIsaName(getBestIsa()) << "\n\n";
+
+  report << juce::String("shape").paddedRight(' ', 8);
+  for (auto isa : isas)
+    report << juce::String(getIsaName(isa)).paddedLeft(' ', 10);
+  report << "\n";
+
+  juce::Array<double> totals;
+  totals.insertMultiple(0, 0.0, isas.size());
+
+  for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+    report << juce::String(shape).paddedRight(' ', 8);
+    for (int i = 0; i < isas.size(); ++i) {
+      const double msps =
+          measure(getKernelTable(isas[i], tier)[static_cast<size_t>(shape)]);
+      totals.set(i, totals[i] + msps);
+      report << juce::String(msps, 1).paddedLeft(' ', 10);
+    }
+    report << "\n";
+  }
+
+  report << juce::String("mean").paddedRight(' ', 8);
+  for (int i = 0; i < isas.size(); ++i)
+    report << juce::String(totals[i] / Waveshapers::numWaveshapes, 1)
+                  .paddedLeft(' ', 10);
+  report << "\n";
+
+  report << juce::String("speedup").paddedRight(' ', 8);
+  for (int i = 0; i < isas.size(); ++i)
+    report << (juce::String(totals[i] / juce::jmax(1.0e-9, totals[0]), 2) + "x")
+                  .paddedLeft(' ', 10);
+  report << "\n";
+
+  return report;
+}
+
+} // namespace SimdWaveshapers
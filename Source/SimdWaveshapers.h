@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    SimdWaveshapers.h
+    -----------------
+    This file declares the SIMD waveshaper engine.
+
+    Role:
+    Provides vectorized block kernels for the curves in Waveshapers.cpp,
+    compiled once per instruction set (SSE2, AVX2, AVX-512, NEON). The
+    widest set the host CPU supports is picked the first time the engine is
+    used. The plain scalar kernels from Waveshapers.h stay available as the
+    fallback (and for the few curves that cannot be vectorized).
+
+    Every instruction set also has one table per FastMath accuracy tier
+    (Exact, High, Eco), chosen by the "quality" parameter.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FastMath.h"
+#include "Waveshapers.h"
+#include <JuceHeader.h>
+#include <array>
+
+namespace SimdWaveshapers {
+
+enum class Isa { Scalar, SSE2, AVX2, AVX512, NEON };
+
+// One block kernel per waveshape, indexed like the "waveshape" parameter.
+using KernelTable =
+    std::array<Waveshapers::BlockKernel, Waveshapers::numWaveshapes>;
+
+// Widest instruction set supported by this build AND this CPU (cached).
+Isa getBestIsa();
+
+// True if kernels for this instruction set can run on this machine.
+bool isIsaAvailable(Isa isa);
+
+const char *getIsaName(Isa isa);
+
+// Kernel table for an instruction set and accuracy tier. Falls back to the
+// scalar table if the set is not available. The Exact scalar table is the
+// original std:: based code from Waveshapers.cpp; the Exact SIMD tables
+// run the FastMath polynomials and differ from it by about 1e-5 (see
+// FastMath.h).
+const KernelTable &getKernelTable(Isa isa,
+                                  FastMath::Tier tier = FastMath::Tier::Exact);
+
+// Times every kernel of every available instruction set (for one tier) and
+// returns a human-readable table (Msamples/s per waveshape and per ISA).
+juce::String createThroughputReport(FastMath::Tier tier, int numSamples = 4096,
+                                    int numRepeats = 200);
+
+} // namespace SimdWaveshapers
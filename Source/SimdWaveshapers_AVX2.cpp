@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    SimdWaveshapers_AVX2.cpp
+    ------------------------
+    AVX2 + FMA waveshaper kernels (8 floats per register).
+
+    Role:
+    CMake compiles this file alone with AVX2/FMA enabled. Nothing here runs
+    unless SimdWaveshapers.cpp has checked the CPU supports it first.
+    It includes nothing but SimdWaveshaperKernels.h and the intrinsics, so
+    no JUCE or standard library code is built with these flags (see
+    FastMathVec.h).
+
+  ==============================================================================
+*/
+
+#include "SimdWaveshaperKernels.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+namespace SimdWaveshapers {
+namespace {
+
+struct Avx2Ops {
+  using Reg = __m256;
+  using Mask = __m256;
+  static constexpr int width = 8;
+
+  static Reg broadcast(float x) { return _mm256_set1_ps(x); }
+  static Reg load(const float *p) { return _mm256_loadu_ps(p); }
+  static void store(float *p, Reg v) { _mm256_storeu_ps(p, v); }
+
+  static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+  static Reg mulAdd(Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+  static Reg min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+  static Reg abs(Reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  static Reg sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+
+  static Mask cmpGt(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static Mask cmpLt(Reg a, Reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static Reg select(Mask m, Reg a, Reg b) { return _mm256_blendv_ps(b, a, m); }
+
+  static Reg signBits(Reg a) { return _mm256_and_ps(a, _mm256_set1_ps(-0.0f)); }
+  static Reg orBits(Reg a, Reg b) { return _mm256_or_ps(a, b); }
+  static Reg xorBits(Reg a, Reg b) { return _mm256_xor_ps(a, b); }
+
+  static Reg roundNearest(Reg a) {
+    return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static Reg exp2Int(Reg n) {
+    const __m256i biased =
+        _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+  }
+  static Reg frexp(Reg x, Reg &exponent) {
+    const __m256i bits = _mm256_castps_si256(x);
+    const __m256i e = _mm256_sub_epi32(
+        _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xff)),
+        _mm256_set1_epi32(126));
+    exponent = _mm256_cvtepi32_ps(e);
+    const __m256i mantissa =
+        _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x807fffff)),
+                        _mm256_set1_epi32(0x3f000000));
+    return _mm256_castsi256_ps(mantissa);
+  }
+};
+
+} // namespace
+
+namespace detail {
+bool fillAvx2Kernels(FastMath::Tier tier, BlockKernel *kernels) {
+  fillKernels<Avx2Ops>(tier, kernels);
+  return true;
+}
+} // namespace detail
+} // namespace SimdWaveshapers
+
+#else
+
+namespace SimdWaveshapers::detail {
+bool fillAvx2Kernels(FastMath::Tier, BlockKernel *) { return false; }
+} // namespace SimdWaveshapers::detail
+
+#endif
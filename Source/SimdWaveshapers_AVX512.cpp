@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    SimdWaveshapers_AVX512.cpp
+    --------------------------
+    AVX-512F waveshaper kernels (16 floats per register).
+
+    Role:
+    CMake compiles this file alone with AVX-512F/FMA enabled. Nothing here
+    runs unless SimdWaveshapers.cpp has checked the CPU supports it first.
+    It includes nothing but SimdWaveshaperKernels.h and the intrinsics, so
+    no JUCE or standard library code is built with these flags (see
+    FastMathVec.h).
+
+  ==============================================================================
+*/
+
+#include "SimdWaveshaperKernels.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace SimdWaveshapers {
+namespace {
+
+struct Avx512Ops {
+  using Reg = __m512;
+  using Mask = __mmask16;
+  static constexpr int width = 16;
+
+  static Reg broadcast(float x) { return _mm512_set1_ps(x); }
+  static Reg load(const float *p) { return _mm512_loadu_ps(p); }
+  static void store(float *p, Reg v) { _mm512_storeu_ps(p, v); }
+
+  static Reg add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  static Reg sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+  static Reg mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg div(Reg a, Reg b) { return _mm512_div_ps(a, b); }
+  static Reg mulAdd(Reg a, Reg b, Reg c) { return _mm512_fmadd_ps(a, b, c); }
+  static Reg min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+  static Reg max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+  static Reg abs(Reg a) { return _mm512_abs_ps(a); }
+  static Reg sqrt(Reg a) { return _mm512_sqrt_ps(a); }
+
+  static Mask cmpGt(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+  static Mask cmpLt(Reg a, Reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static Reg select(Mask m, Reg a, Reg b) { return _mm512_mask_blend_ps(m, b, a); }
+
+  static Reg signBits(Reg a) {
+    return _mm512_castsi512_ps(_mm512_and_si512(
+        _mm512_castps_si512(a), _mm512_set1_epi32(int(0x80000000u))));
+  }
+  static Reg orBits(Reg a, Reg b) {
+    return _mm512_castsi512_ps(
+        _mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+  }
+  static Reg xorBits(Reg a, Reg b) {
+    return _mm512_castsi512_ps(
+        _mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+  }
+
+  static Reg roundNearest(Reg a) {
+    return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static Reg exp2Int(Reg n) {
+    const __m512i biased =
+        _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(biased, 23));
+  }
+  static Reg frexp(Reg x, Reg &exponent) {
+    const __m512i bits = _mm512_castps_si512(x);
+    const __m512i e = _mm512_sub_epi32(
+        _mm512_and_si512(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(0xff)),
+        _mm512_set1_epi32(126));
+    exponent = _mm512_cvtepi32_ps(e);
+    const __m512i mantissa =
+        _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x807fffff)),
+                        _mm512_set1_epi32(0x3f000000));
+    return _mm512_castsi512_ps(mantissa);
+  }
+};
+
+} // namespace
+
+namespace detail {
+bool fillAvx512Kernels(FastMath::Tier tier, BlockKernel *kernels) {
+  fillKernels<Avx512Ops>(tier, kernels);
+  return true;
+}
+} // namespace detail
+} // namespace SimdWaveshapers
+
+#else
+
+namespace SimdWaveshapers::detail {
+bool fillAvx512Kernels(FastMath::Tier, BlockKernel *) { return false; }
+} // namespace SimdWaveshapers::detail
+
+#endif
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    StageTimings.h
+    --------------
+    Per-stage timing of processBlock(), for DevTools.
+
+    Role:
+    cpuUsage is one average over the whole block. While DevTools is open,
+    the processor also times each stage of every chunk and adds the
+    duration to that stage's TimingHistogram, so DevTools can show which
+    stage takes the time (average and p99 per chunk) for the current
+    settings. When timing is off (DevTools closed), a stage costs one
+    relaxed atomic load.
+
+    When Mix or Delta is in use, the output gain is applied in the mix
+    loop and counted as "Mix/Delta".
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "TimingHistogram.h"
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+class StageTimings {
+public:
+  enum Stage {
+    inputGain,
+    crossover,
+    upsample,
+    shaper,
+    downsample,
+    mixDelta,
+    outputGain,
+    limiter,
+    analyzerPush,
+    envelope,
+    numStages
+  };
+
+  static const char *getName(int stage) {
+    static const char *const names[numStages] = {
+        "Input Gain", "Crossover", "Upsample",  "Shaper",   "Downsample",
+        "Mix/Delta",  "Output",    "Limiter",   "Analyzer", "Envelope"};
+    return names[stage];
+  }
+
+  // Any thread
+  void setEnabled(bool shouldEnable) {
+    enabled.store(shouldEnable, std::memory_order_relaxed);
+  }
+
+  TimingHistogram::Snapshot getSnapshot(int stage) const {
+    return histograms[(size_t)stage].getSnapshot();
+  }
+
+  // Only while the audio thread is stopped (prepareToPlay())
+  void reset() {
+    for (auto &histogram : histograms)
+      histogram.reset();
+  }
+
+  //==============================================================================
+  // Audio thread: times its scope into one stage
+  class Scope {
+  public:
+    Scope(StageTimings &timingsToUse, Stage stageToTime) noexcept
+        : timings(timingsToUse), stage(stageToTime),
+          start(timings.enabled.load(std::memory_order_relaxed)
+                    ? juce::Time::getHighResolutionTicks()
+                    : 0) {}
+
+    ~Scope() noexcept {
+      if (start != 0)
+        timings.histograms[(size_t)stage].add((juce::uint64)(
+            (double)(juce::Time::getHighResolutionTicks() - start) *
+            timings.nanosecondsPerTick));
+    }
+
+  private:
+    StageTimings &timings;
+    const Stage stage;
+    const juce::int64 start;
+
+    JUCE_DECLARE_NON_COPYABLE(Scope)
+  };
+
+private:
+  std::atomic<bool> enabled{false};
+  const double nanosecondsPerTick =
+      1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+  std::array<TimingHistogram, numStages> histograms;
+};
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    TimingHistogram.h
+    -----------------
+    Lock-free histogram of durations, for DevTools.
+
+    Role:
+    The audio thread adds durations (in nanoseconds; DeadlineMonitor adds
+    block loads in parts per million) with a few relaxed atomic stores and
+    no locks; the message thread reads a snapshot and
+    computes the average and percentiles from it. There is one writer, so
+    add() loads and stores instead of using read-modify-write operations.
+    A snapshot taken while the writer is adding can be off by one value,
+    which is fine for display.
+
+    Buckets are logarithmic: 4 per octave from 16 ns up to ~2 s (longer
+    durations land in the last bucket), so a percentile is known to within
+    25% whatever the scale. Percentiles report the upper edge of their
+    bucket.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <limits>
+
+class TimingHistogram {
+public:
+  static constexpr int bucketsPerOctave = 4;
+  static constexpr int firstOctave = 4;  // 2^4 = 16 ns
+  static constexpr int numOctaves = 27;  // up to 2^31 ns
+  static constexpr int numBuckets = numOctaves * bucketsPerOctave;
+
+  //==============================================================================
+  // Writer (audio thread)
+  void add(juce::uint64 nanoseconds) noexcept {
+    const auto relaxed = std::memory_order_relaxed;
+    auto &bucket = buckets[(size_t)getBucket(nanoseconds)];
+    bucket.store(bucket.load(relaxed) + 1, relaxed);
+    count.store(count.load(relaxed) + 1, relaxed);
+    total.store(total.load(relaxed) + nanoseconds, relaxed);
+    if (nanoseconds > maximum.load(relaxed))
+      maximum.store(nanoseconds, relaxed);
+  }
+
+  // Only while the writer is stopped (prepareToPlay())
+  void reset() noexcept {
+    for (auto &bucket : buckets)
+      bucket.store(0, std::memory_order_relaxed);
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+  }
+
+  //==============================================================================
+  // Readers (any thread)
+  struct Snapshot {
+    std::array<juce::uint64, numBuckets> buckets{};
+    juce::uint64 count = 0, total = 0, maximum = 0; // nanoseconds
+
+    double getAverage() const {
+      return count > 0 ? (double)total / (double)count : 0.0;
+    }
+
+    // Upper edge of the bucket that holds this fraction (0.99 = p99) of
+    // the durations, in nanoseconds (never above the maximum)
+    double getPercentile(double fraction) const {
+      juce::uint64 bucketCount = 0;
+      for (const auto n : buckets)
+        bucketCount += n;
+      if (bucketCount == 0)
+        return 0.0;
+      const auto rank = (juce::uint64)std::ceil(fraction * (double)bucketCount);
+      juce::uint64 seen = 0;
+      for (int i = 0; i < numBuckets; ++i) {
+        seen += buckets[(size_t)i];
+        if (seen >= rank)
+          return juce::jmin(getUpperEdge(i), (double)maximum);
+      }
+      return (double)maximum;
+    }
+  };
+
+  Snapshot getSnapshot() const noexcept {
+    Snapshot snapshot;
+    for (int i = 0; i < numBuckets; ++i)
+      snapshot.buckets[(size_t)i] =
+          buckets[(size_t)i].load(std::memory_order_relaxed);
+    snapshot.count = count.load(std::memory_order_relaxed);
+    snapshot.total = total.load(std::memory_order_relaxed);
+    snapshot.maximum = maximum.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  //==============================================================================
+  static int getBucket(juce::uint64 nanoseconds) noexcept {
+    if (nanoseconds < ((juce::uint64)1 << firstOctave))
+      return 0;
+    const auto clamped = (juce::uint32)juce::jmin(
+        nanoseconds, (juce::uint64)std::numeric_limits<juce::uint32>::max());
+    const int octave = juce::findHighestSetBit(clamped);
+    // The two bits below the highest one pick the quarter of the octave
+    const int quarter = (int)(clamped >> (octave - 2)) & 3;
+    return juce::jmin(numBuckets - 1,
+                      (octave - firstOctave) * bucketsPerOctave + quarter);
+  }
+
+  static double getUpperEdge(int bucket) noexcept {
+    const int octave = firstOctave + bucket / bucketsPerOctave;
+    const int quarter = bucket % bucketsPerOctave;
+    return std::ldexp(1.0 + (quarter + 1) / (double)bucketsPerOctave, octave);
+  }
+
+private:
+  std::array<std::atomic<juce::uint64>, numBuckets> buckets{};
+  std::atomic<juce::uint64> count{0}, total{0}, maximum{0};
+};
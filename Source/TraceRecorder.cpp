@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    -----------------
+    Writer side of the trace recorder (see TraceRecorder.h).
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+namespace {
+
+const char *const eventNames[TraceRecorder::numEvents] = {
+    "processBlock", "processChunk", "VisualizerTabComponent::timerCallback",
+    "Editor paint"};
+
+const char *const trackNames[TraceRecorder::numTracks] = {
+    "Audio thread", "Visualizer timer", "Editor paint"};
+
+// How often the writer thread drains the rings
+constexpr int drainIntervalMs = 20;
+
+} // namespace
+
+TraceRecorder::TraceRecorder() : juce::Thread("Steverator trace writer") {}
+
+TraceRecorder::~TraceRecorder() { stop(); }
+
+bool TraceRecorder::start(const juce::File &file) {
+  if (isRecording())
+    return true;
+
+  file.deleteFile();
+  auto newStream = std::make_unique<juce::FileOutputStream>(file);
+  if (!newStream->openedOk())
+    return false;
+  stream = std::move(newStream);
+  traceFile = file;
+
+  // The JSON header, with a name for each track
+  stream->writeText("{\"traceEvents\":[\n", false, false, nullptr);
+  for (int track = 0; track < numTracks; ++track)
+    stream->writeText(
+        juce::String(track == 0 ? "" : ",\n") +
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" +
+            juce::String(track + 1) + ",\"args\":{\"name\":\"" +
+            trackNames[track] + "\"}}",
+        false, false, nullptr);
+
+  for (auto &ring : rings)
+    ring.discard();
+  numDropped = 0;
+  startTicks = juce::Time::getHighResolutionTicks();
+  recording.store(true, std::memory_order_release);
+  startThread();
+  return true;
+}
+
+void TraceRecorder::stop() {
+  if (!isRecording())
+    return;
+
+  recording.store(false, std::memory_order_release);
+  stopThread(2000);
+  writePendingEvents();
+  stream->writeText("\n]}\n", false, false, nullptr);
+  stream->flush();
+  stream.reset();
+}
+
+void TraceRecorder::run() {
+  while (!threadShouldExit()) {
+    writePendingEvents();
+    wait(drainIntervalMs);
+  }
+}
+
+void TraceRecorder::writePendingEvents() {
+  for (int track = 0; track < numTracks; ++track) {
+    const juce::String tid(track + 1);
+    rings[(size_t)track].drain([&](const Record &record) {
+      const double timestamp =
+          (double)(record.ticks - startTicks) * microsecondsPerTick;
+      stream->writeText(",\n{\"name\":\"" +
+                            juce::String(eventNames[record.event]) +
+                            "\",\"ph\":\"" + (record.begin ? "B" : "E") +
+                            "\",\"ts\":" + juce::String(timestamp, 3) +
+                            ",\"pid\":1,\"tid\":" + tid + "}",
+                        false, false, nullptr);
+    });
+  }
+}
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    ---------------
+    Optional timeline of the audio thread, the visualizer timer and the
+    editor paint, written as a Chrome trace_event JSON file.
+
+    Role:
+    DevTools averages hide when things happen relative to each other (does
+    a slow VisualizerTabComponent::timerCallback() line up with a slow
+    audio block?). While a trace is recording, each of those places opens a
+    Scope, which pushes a begin and an end event into a ring of its own:
+
+      - One preallocated single-producer / single-consumer ring per track
+        (audio thread, visualizer timer, editor paint). Pushing is a
+        timestamp, one store into the ring and a release store of the
+        write index: no locks and no allocation. A full ring drops the
+        event and counts it.
+      - A background thread drains the rings every few milliseconds and
+        appends the events to the file; stop() drains what is left and
+        closes the JSON.
+
+    When no trace is recording, a Scope costs one relaxed atomic load. The
+    file opens in chrome://tracing or https://ui.perfetto.dev.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class TraceRecorder : private juce::Thread {
+public:
+  // One ring (and one row of the timeline) per producer thread
+  enum Track { audioTrack, visualizerTrack, paintTrack, numTracks };
+
+  enum Event : juce::uint8 {
+    processBlock,
+    processChunk,
+    visualizerTimer,
+    editorPaint,
+    numEvents
+  };
+
+  TraceRecorder();
+  ~TraceRecorder() override;
+
+  //==============================================================================
+  // Message thread
+
+  // Starts writing a new trace to file; false if it cannot be written
+  bool start(const juce::File &file);
+  // Writes the remaining events and closes the file
+  void stop();
+
+  bool isRecording() const { return recording.load(); }
+  const juce::File &getFile() const { return traceFile; }
+  // Events lost because a ring was full (since start())
+  juce::int64 getNumDropped() const { return numDropped.load(); }
+
+  //==============================================================================
+  // Producers: the begin event when constructed, the end event when
+  // destroyed (only one thread may use each track)
+  class Scope {
+  public:
+    Scope(TraceRecorder &recorderToUse, Track trackToUse,
+          Event eventToRecord) noexcept
+        : recorder(recorderToUse), track(trackToUse), event(eventToRecord),
+          active(recorder.recording.load(std::memory_order_relaxed)) {
+      if (active)
+        recorder.push(track, event, true);
+    }
+
+    ~Scope() noexcept {
+      if (active)
+        recorder.push(track, event, false);
+    }
+
+  private:
+    TraceRecorder &recorder;
+    const Track track;
+    const Event event;
+    const bool active;
+
+    JUCE_DECLARE_NON_COPYABLE(Scope)
+  };
+
+private:
+  struct Record {
+    juce::int64 ticks = 0;
+    Event event = processBlock;
+    bool begin = false;
+  };
+
+  class Ring {
+  public:
+    static constexpr juce::uint32 capacity = 1 << 14; // a power of two
+
+    Ring() : records(capacity) {}
+
+    // Producer
+    bool push(const Record &record) noexcept {
+      const auto write = writeIndex.load(std::memory_order_relaxed);
+      if (write - readIndex.load(std::memory_order_acquire) >= capacity)
+        return false;
+      records[write & (capacity - 1)] = record;
+      writeIndex.store(write + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer
+    template <typename Function> void drain(Function &&function) {
+      auto read = readIndex.load(std::memory_order_relaxed);
+      const auto write = writeIndex.load(std::memory_order_acquire);
+      for (; read != write; ++read)
+        function(records[read & (capacity - 1)]);
+      readIndex.store(read, std::memory_order_release);
+    }
+
+    // Consumer: forgets what is waiting (events from a previous trace)
+    void discard() noexcept {
+      readIndex.store(writeIndex.load(std::memory_order_acquire),
+                      std::memory_order_release);
+    }
+
+  private:
+    std::vector<Record> records;
+    std::atomic<juce::uint32> writeIndex{0}, readIndex{0};
+  };
+
+  void push(Track track, Event event, bool begin) noexcept {
+    if (!rings[(size_t)track].push(
+            {juce::Time::getHighResolutionTicks(), event, begin}))
+      numDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void run() override;
+  void writePendingEvents();
+
+  std::array<Ring, numTracks> rings;
+  std::atomic<bool> recording{false};
+  std::atomic<juce::int64> numDropped{0};
+
+  // Consumer side (message thread while stopped, then the writer thread)
+  juce::File traceFile;
+  std::unique_ptr<juce::FileOutputStream> stream;
+  juce::int64 startTicks = 0;
+  const double microsecondsPerTick =
+      1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRecorder)
+};
@@ -484,8 +484,9 @@ void VisualizerGridComponent::resized() {
 }
 
 VisualizerTabComponent::VisualizerTabComponent(AnalyzerTap &tapToUse,
-                                               juce::ValueTree stateRoot)
-    : tap(tapToUse), analysis(tapToUse),
+                                               juce::ValueTree stateRoot,
+                                               TraceRecorder &traceRecorderToUse)
+    : tap(tapToUse), traceRecorder(traceRecorderToUse), analysis(tapToUse),
       deltaPanel(0, "Delta / Harmonics",
                  juce::Colour::fromFloatRGBA(0.93f, 0.90f, 0.82f, 1.0f)),
       shaperPanel(1, "Wave Shaper",
@@ -544,6 +545,9 @@ void VisualizerTabComponent::paint(juce::Graphics &g) {
 }
 
 void VisualizerTabComponent::timerCallback() {
+  const TraceRecorder::Scope trace(traceRecorder,
+                                   TraceRecorder::visualizerTrack,
+                                   TraceRecorder::visualizerTimer);
   const double startTime = juce::Time::getMillisecondCounterHiRes();
   analysis.updateFrame(frame);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "TraceRecorder.h"
 #include "VisualizerAnalysis.h"
 #include <JuceHeader.h>
 #include <array>
@@ -82,7 +83,8 @@ private:
 class VisualizerTabComponent final : public juce::Component,
                                      private juce::Timer {
 public:
-  VisualizerTabComponent(AnalyzerTap &tapToUse, juce::ValueTree stateRoot);
+  VisualizerTabComponent(AnalyzerTap &tapToUse, juce::ValueTree stateRoot,
+                         TraceRecorder &traceRecorderToUse);
   ~VisualizerTabComponent() override;
 
   void setActive(bool shouldBeActive);
@@ -109,6 +111,7 @@ private:
   void configurePanelModes();
 
   AnalyzerTap &tap;
+  TraceRecorder &traceRecorder;
   VisualizerAnalysisEngine analysis;
   VisualizerFrameData frame;
   VisualizerPanelComponent deltaPanel;
@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+    WaveshaperTable.cpp
+    -------------------
+    Implementation of the lookup-table waveshaper mode (see
+    WaveshaperTable.h for the slot hand-off rules).
+
+  ==============================================================================
+*/
+
+#include "WaveshaperTable.h"
+#include <cmath>
+#include <cstring>
+
+//==============================================================================
+// One background thread shared by every plugin instance. It polls the
+// registered tables and builds whatever they asked for. The lock is only
+// taken here and when an instance is created or destroyed, never by the
+// audio thread.
+class WaveshaperTable::BuilderThread : private juce::Thread {
+public:
+  BuilderThread() : juce::Thread("Steverator Table Builder") { startThread(); }
+  ~BuilderThread() override { stopThread(2000); }
+
+  void add(WaveshaperTable *table) {
+    const juce::ScopedLock sl(lock);
+    tables.addIfNotAlreadyThere(table);
+  }
+
+  void remove(WaveshaperTable *table) {
+    const juce::ScopedLock sl(lock);
+    tables.removeFirstMatchingValue(table);
+  }
+
+private:
+  void run() override {
+    while (!threadShouldExit()) {
+      {
+        const juce::ScopedLock sl(lock);
+        for (auto *table : tables)
+          table->serviceRequests();
+      }
+      wait(5);
+    }
+  }
+
+  juce::CriticalSection lock;
+  juce::Array<WaveshaperTable *> tables;
+};
+
+//==============================================================================
+namespace {
+constexpr float tableScale =
+    (float)WaveshaperTable::numIntervals / (2.0f * WaveshaperTable::range);
+
+inline float lookup(const float *values, Waveshapers::SampleFunction curve,
+                    float shape, float x) {
+  // Outside the table (or NaN): evaluate the curve directly
+  if (!(std::abs(x) < WaveshaperTable::range))
+    return curve(x, shape);
+
+  const float position = (x + WaveshaperTable::range) * tableScale;
+  const int index = juce::jmin((int)position, WaveshaperTable::numIntervals - 1);
+  const float fraction = position - (float)index;
+  return values[index] + fraction * (values[index + 1] - values[index]);
+}
+
+// First-order ADAA over one table. The antiderivative of the linearly
+// interpolated curve is exact (a quadratic between two table points), so
+// small input steps converge to the same output as lookup().
+struct AdaaCursor {
+  AdaaCursor(const float *valuesToUse, const double *integralsToUse,
+             Waveshapers::SampleFunction curveToUse, float shapeToUse,
+             double x)
+      : values(valuesToUse), integrals(integralsToUse), curve(curveToUse),
+        shape(shapeToUse), x0(x), inRange0(std::abs(x) < WaveshaperTable::range),
+        F0(inRange0 ? integral(x) : 0.0) {}
+
+  float next(double x1) {
+    const bool inRange1 = std::abs(x1) < WaveshaperTable::range;
+    const double F1 = inRange1 ? integral(x1) : 0.0;
+    const double delta = x1 - x0;
+
+    const float y =
+        inRange0 && inRange1 && std::abs(delta) > Adaa::minDelta
+            ? (float)((F1 - F0) / delta)
+            : lookup(values, curve, shape, (float)(0.5 * (x0 + x1)));
+
+    x0 = x1;
+    F0 = F1;
+    inRange0 = inRange1;
+    return y;
+  }
+
+private:
+  double integral(double x) const {
+    const double position = (x + WaveshaperTable::range) * tableScale;
+    const int index =
+        juce::jmin((int)position, WaveshaperTable::numIntervals - 1);
+    const double t = position - (double)index;
+    const double v0 = values[index], v1 = values[index + 1];
+    return integrals[index] + t * (v0 + 0.5 * t * (v1 - v0)) / tableScale;
+  }
+
+  const float *values;
+  const double *integrals;
+  Waveshapers::SampleFunction curve;
+  float shape;
+  double x0;
+  bool inRange0;
+  double F0;
+};
+} // namespace
+
+//==============================================================================
+WaveshaperTable::WaveshaperTable() {
+  for (auto &slot : slots) {
+    slot.values.resize(static_cast<size_t>(numIntervals + 1), 0.0f);
+    slot.integrals.resize(static_cast<size_t>(numIntervals + 1), 0.0);
+  }
+
+  builder->add(this);
+}
+
+WaveshaperTable::~WaveshaperTable() { builder->remove(this); }
+
+bool WaveshaperTable::supports(int waveshapeIndex) {
+  return juce::isPositiveAndBelow(waveshapeIndex, Waveshapers::numWaveshapes) &&
+         waveshapeIndex != Waveshapers::crackleIndex;
+}
+
+void WaveshaperTable::prepare(double oversampledSampleRate) {
+  // ~10ms crossfade between tables
+  fadeLength = juce::jmax(1, juce::roundToInt(oversampledSampleRate * 0.01));
+
+  // Tables do not depend on the sample rate, so the current one is kept.
+  // Only an unfinished crossfade is cut short.
+  if (fadingFrom >= 0) {
+    release(fadingFrom);
+    fadingFrom = -1;
+  }
+}
+
+juce::uint64 WaveshaperTable::makeKey(int waveshapeIndex, float shape) {
+  juce::uint32 shapeBits;
+  std::memcpy(&shapeBits, &shape, sizeof(shapeBits));
+  // +1 so that a valid key is never 0 ("nothing requested")
+  return ((juce::uint64)(juce::uint32)(waveshapeIndex + 1) << 32) | shapeBits;
+}
+
+bool WaveshaperTable::beginBlock(int waveshapeIndex, float shape,
+                                 bool synchronous) {
+  const auto key = makeKey(waveshapeIndex, shape);
+  if (synchronous) {
+    // Nothing is requested from the background thread. A table it published
+    // earlier is ours once taken out of pending, and is dropped.
+    if (fadingFrom < 0 &&
+        (current < 0 || slots[(size_t)current].key != key)) {
+      const int stale = pending.exchange(-1, std::memory_order_acq_rel);
+      if (stale >= 0)
+        release(stale);
+      const int index = build(key);
+      if (index >= 0)
+        makeLive(index);
+    }
+    return current >= 0;
+  }
+
+  if (key != lastRequestedKey) {
+    requestedKey.store(key, std::memory_order_release);
+    lastRequestedKey = key;
+  }
+
+  // Only switch tables once the previous crossfade is over. A newer table
+  // simply replaces the pending one in the meantime.
+  if (fadingFrom < 0) {
+    const int next = pending.exchange(-1, std::memory_order_acq_rel);
+    if (next >= 0)
+      makeLive(next);
+  }
+
+  return current >= 0;
+}
+
+void WaveshaperTable::makeLive(int slotIndex) {
+  slots[(size_t)slotIndex].state.store(Live, std::memory_order_relaxed);
+  if (current >= 0) {
+    fadingFrom = current;
+    fadePosition = 0;
+  }
+  current = slotIndex;
+}
+
+void WaveshaperTable::processChannel(float *data, int numSamples,
+                                     float drive) const {
+  jassert(current >= 0);
+  const auto &target = slots[(size_t)current];
+
+  if (fadingFrom < 0) {
+    processWithSlot(target, data, numSamples, drive);
+    return;
+  }
+
+  const auto &source = slots[(size_t)fadingFrom];
+  const float step = 1.0f / (float)fadeLength;
+  float gain = (float)fadePosition * step;
+
+  for (int i = 0; i < numSamples; ++i) {
+    const float x = data[i] * drive;
+    const float from =
+        lookup(source.values.data(), source.curve, source.shape, x);
+    const float to = lookup(target.values.data(), target.curve, target.shape, x);
+    const float g = juce::jmin(gain, 1.0f);
+    data[i] = from + g * (to - from);
+    gain += step;
+  }
+}
+
+void WaveshaperTable::processChannelAdaa(float *data, int numSamples,
+                                         float drive,
+                                         Adaa::ChannelState &state) const {
+  jassert(current >= 0);
+  const auto &target = slots[(size_t)current];
+  AdaaCursor to(target.values.data(), target.integrals.data(), target.curve,
+                target.shape, state.previous);
+  double x = state.previous;
+
+  if (fadingFrom < 0) {
+    for (int i = 0; i < numSamples; ++i) {
+      x = (double)data[i] * drive;
+      data[i] = to.next(x);
+    }
+  } else {
+    const auto &source = slots[(size_t)fadingFrom];
+    AdaaCursor from(source.values.data(), source.integrals.data(),
+                    source.curve, source.shape, state.previous);
+    const float step = 1.0f / (float)fadeLength;
+    float gain = (float)fadePosition * step;
+
+    for (int i = 0; i < numSamples; ++i) {
+      x = (double)data[i] * drive;
+      const float a = from.next(x);
+      const float b = to.next(x);
+      data[i] = a + juce::jmin(gain, 1.0f) * (b - a);
+      gain += step;
+    }
+  }
+
+  state.previous = x;
+}
+
+void WaveshaperTable::processWithSlot(const Slot &slot, float *data,
+                                      int numSamples, float drive) const {
+  const float *values = slot.values.data();
+  for (int i = 0; i < numSamples; ++i)
+    data[i] = lookup(values, slot.curve, slot.shape, data[i] * drive);
+}
+
+void WaveshaperTable::endBlock(int numSamples) {
+  if (fadingFrom < 0)
+    return;
+
+  fadePosition += numSamples;
+  if (fadePosition >= fadeLength) {
+    release(fadingFrom);
+    fadingFrom = -1;
+  }
+}
+
+void WaveshaperTable::release(int slotIndex) {
+  slots[(size_t)slotIndex].state.store(Free, std::memory_order_release);
+}
+
+//==============================================================================
+void WaveshaperTable::serviceRequests() {
+  const auto key = requestedKey.load(std::memory_order_acquire);
+  if (key == 0 || key == builtKey)
+    return;
+
+  const int index = build(key);
+  if (index < 0)
+    return;
+  builtKey = key;
+
+  // Publish. If the audio thread never picked up the previous table, it is
+  // ours again and can be freed.
+  const int previous = pending.exchange(index, std::memory_order_acq_rel);
+  if (previous >= 0)
+    release(previous);
+}
+
+int WaveshaperTable::build(juce::uint64 key) {
+  // Claim a free slot (there is always one: at most one Live + one fading +
+  // one pending slot are in use while we build)
+  int index = -1;
+  for (int i = 0; i < (int)slots.size() && index < 0; ++i) {
+    int expected = Free;
+    if (slots[(size_t)i].state.compare_exchange_strong(
+            expected, Building, std::memory_order_acquire))
+      index = i;
+  }
+  if (index < 0)
+    return -1;
+
+  auto &slot = slots[(size_t)index];
+  slot.key = key;
+  const juce::uint32 shapeBits = (juce::uint32)(key & 0xffffffffu);
+  slot.waveshapeIndex = (int)(key >> 32) - 1;
+  std::memcpy(&slot.shape, &shapeBits, sizeof(slot.shape));
+  slot.curve = Waveshapers::getSampleFunction(slot.waveshapeIndex);
+
+  const float stepSize = 1.0f / tableScale;
+  for (int i = 0; i <= numIntervals; ++i)
+    slot.values[(size_t)i] = slot.curve(-range + (float)i * stepSize, slot.shape);
+
+  // Trapezoids integrate the interpolated curve exactly
+  slot.integrals[0] = 0.0;
+  for (int i = 0; i < numIntervals; ++i)
+    slot.integrals[(size_t)i + 1] =
+        slot.integrals[(size_t)i] +
+        0.5 * ((double)slot.values[(size_t)i] + slot.values[(size_t)i + 1]) /
+            tableScale;
+
+  slot.state.store(Ready, std::memory_order_relaxed);
+  return index;
+}
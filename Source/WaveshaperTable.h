@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    WaveshaperTable.h
+    -----------------
+    Lookup-table ("Table") mode for the waveshaper.
+
+    Role:
+    Bakes the selected waveshape and "shape" value into a dense table so
+    every oversampled sample costs one fetch and one lerp, whatever the
+    curve. Tables are built on a shared background thread and handed to
+    the audio thread without locks:
+
+      - 4 preallocated slots, each Free, Building, Ready or Live.
+      - The audio thread publishes what it wants (waveshape + shape) in one
+        atomic and picks up finished tables through an atomic "pending"
+        slot index. Whoever takes an index out of "pending" owns the slot.
+      - When a new table arrives, the audio thread crossfades from the old
+        table to the new one over ~10 ms, then frees the old slot.
+      - While the host renders offline, the audio thread builds the table
+        itself (synchronous beginBlock()), so a bounce does not depend on
+        when the background thread gets to it.
+
+    The drive gain is applied before the lookup, so moving Drive never
+    triggers a rebuild. Inputs outside the table range fall back to the
+    direct curve. Smooth curves stay within ~1e-3 of the direct output
+    (CMOS, whose square root is steep near zero, within ~1e-2); curves
+    with jumps (folds, Bit Crush, Wrap) can move each jump by up to one
+    table step (2 * range / numIntervals = ~0.004).
+
+    Each table also stores the antiderivative of the interpolated curve
+    (in double precision), which ADAA mode uses for the waveshapes that
+    have no closed-form antiderivative (see Adaa.h).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Adaa.h"
+#include "Waveshapers.h"
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+class WaveshaperTable {
+public:
+  // The table covers driven inputs in [-range, range]
+  static constexpr float range = 16.0f;
+  static constexpr int numIntervals = 8192;
+
+  WaveshaperTable();
+  ~WaveshaperTable();
+
+  // Crackle is random, so it cannot be baked into a table.
+  static bool supports(int waveshapeIndex);
+
+  // Sets the crossfade length (in oversampled samples) and cuts a running
+  // crossfade short. Called from prepareToPlay() and by the audio thread
+  // when the oversampling factor changes.
+  void prepare(double oversampledSampleRate);
+
+  //==============================================================================
+  // Audio thread, once per block, in this order:
+
+  // Asks for a table matching (waveshape, shape) and picks up a finished
+  // table if there is one. Returns false while no table is available yet
+  // (the caller should use the direct kernel for this block).
+  // synchronous (offline rendering) builds a missing table right away
+  // instead, so it never returns false for a supported waveshape.
+  bool beginBlock(int waveshapeIndex, float shape, bool synchronous = false);
+
+  // Drive + table lookup for one channel, in place.
+  void processChannel(float *data, int numSamples, float drive) const;
+
+  // Drive + ADAA with the tabulated antiderivative, for one channel.
+  // Inputs outside the table use the curve at the midpoint instead.
+  void processChannelAdaa(float *data, int numSamples, float drive,
+                          Adaa::ChannelState &state) const;
+
+  // Advances the crossfade by the number of samples of one channel.
+  void endBlock(int numSamples);
+
+  //==============================================================================
+  // Background thread: builds the requested table if it is not built yet.
+  void serviceRequests();
+
+private:
+  enum SlotState : int { Free, Building, Ready, Live };
+
+  struct Slot {
+    std::atomic<int> state{Free};
+    juce::uint64 key = 0;
+    int waveshapeIndex = -1;
+    float shape = 0.0f;
+    Waveshapers::SampleFunction curve = nullptr;
+    std::vector<float> values;
+    std::vector<double> integrals; // antiderivative at each table point
+  };
+
+  static juce::uint64 makeKey(int waveshapeIndex, float shape);
+  // Claims a free slot and fills it; -1 if none is free
+  int build(juce::uint64 key);
+  // Audio thread: makes a slot current, crossfading from the previous one
+  void makeLive(int slotIndex);
+  void processWithSlot(const Slot &slot, float *data, int numSamples,
+                       float drive) const;
+  void release(int slotIndex);
+
+  std::array<Slot, 4> slots;
+  std::atomic<int> pending{-1};
+  std::atomic<juce::uint64> requestedKey{0};
+  juce::uint64 builtKey = 0; // background thread only
+
+  // Audio thread state
+  int current = -1;
+  int fadingFrom = -1;
+  int fadePosition = 0;
+  int fadeLength = 1;
+  juce::uint64 lastRequestedKey = 0;
+
+  class BuilderThread;
+  juce::SharedResourcePointer<BuilderThread> builder;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveshaperTable)
+};
@@ -0,0 +1,534 @@
+/*
+  ==============================================================================
+
+    Waveshapers.cpp
+    ---------------
+    This file implements the saturation curves declared in Waveshapers.h.
+
+    Each curve is a small inline function. A template turns every curve into
+    a block kernel, and the kernels are gathered in a table indexed like the
+    "waveshape" parameter.
+
+  ==============================================================================
+*/
+
+#include "Waveshapers.h"
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+constexpr float pi = juce::MathConstants<float>::pi;
+
+inline float signOf(float x) { return x > 0.0f ? 1.0f : -1.0f; }
+
+// === CLASSIC (0-9) ===
+inline float tube(float x, float shape) {
+  float soft = std::tanh(x * (1.0f - shape * 0.5f));
+  float hard = (x - x * x * x / 3.0f);
+  return soft * (1.0f - shape) + hard * shape;
+}
+
+inline float softClip(float x, float shape) {
+  return std::tanh(x * (1.0f + shape * 2.0f));
+}
+
+inline float hardClip(float x, float shape) {
+  return juce::jlimit(-1.0f, 1.0f, x * (1.0f + shape * 3.0f));
+}
+
+inline float diode1(float x, float shape) {
+  return x > 0.0f ? std::tanh(x * (1.0f + shape)) : x * 0.5f;
+}
+
+inline float diode2(float x, float shape) {
+  return x > 0.0f ? x * 0.7f : std::tanh(x * (1.0f + shape * 2.0f));
+}
+
+inline float linearFold(float x, float shape) {
+  float threshold = 1.0f - shape * 0.5f;
+  float output = x;
+  if (std::abs(x) > threshold)
+    output = threshold - (std::abs(x) - threshold);
+  return juce::jlimit(-1.0f, 1.0f, output);
+}
+
+inline float sinFold(float x, float shape) {
+  return std::sin(x * pi * (1.0f + shape * 2.0f));
+}
+
+inline float zeroSquare(float x, float shape) {
+  return x * x * (x > 0.0f ? 1.0f : -1.0f) * (1.0f + shape);
+}
+
+// Downsample (simplified for oversampling context)
+inline float downsample(float x, float shape) {
+  return std::tanh(x * (1.0f + shape));
+}
+
+inline float asym(float x, float shape) {
+  return x > 0.0f ? std::tanh(x * (1.0f + shape * 2.0f)) : x * 0.3f;
+}
+
+// === SHAPERS (10-19) ===
+inline float rectify(float x, float shape) {
+  return std::abs(x) * (1.0f - shape * 0.5f);
+}
+
+inline float xShaper(float x, float shape) {
+  return x * (1.0f + shape) / (1.0f + shape * std::abs(x));
+}
+
+inline float xShaperAsym(float x, float shape) {
+  return x > 0.0f ? x * (1.0f + shape * 2.0f) / (1.0f + shape * std::abs(x))
+                  : x * 0.5f;
+}
+
+inline float sineShaper(float x, float shape) {
+  return std::sin(std::tanh(x) * pi * 0.5f * (1.0f + shape));
+}
+
+inline float stompBox(float x, float shape) {
+  return std::atan(x * (1.0f + shape * 5.0f)) / pi;
+}
+
+inline float tapeSat(float x, float shape) {
+  float wet = std::tanh(x * 1.5f);
+  return x * (1.0f - shape) + wet * shape;
+}
+
+inline float overdrive(float x, float shape) {
+  return (2.0f / pi) * std::atan(x * (1.0f + shape * 10.0f));
+}
+
+inline float softSat(float x, float shape) {
+  return x / (1.0f + std::abs(x) * shape);
+}
+
+inline float bitCrush(float x, float shape) {
+  float levels = 2.0f + (1.0f - shape) * 30.0f;
+  return std::round(x * levels) / levels;
+}
+
+inline float glitchFold(float x, float shape) {
+  return x * std::sin(x * shape * pi);
+}
+
+// === ANALOG (20-27) ===
+inline float valve(float x, float shape) {
+  float bias = 0.2f * shape;
+  float x_biased = x + bias;
+  return x_biased / (1.0f + std::abs(x_biased));
+}
+
+inline float fuzzFac(float x, float shape) {
+  return signOf(x) * (1.0f - std::exp(-std::abs(x * (1.0f + shape * 10.0f))));
+}
+
+inline float cheby3(float x, float shape) {
+  float x_limited = juce::jlimit(-1.0f, 1.0f, x);
+  return (4.0f * x_limited * x_limited * x_limited - 3.0f * x_limited) *
+         (0.5f + shape * 0.5f);
+}
+
+inline float cheby5(float x, float shape) {
+  float x_limited = juce::jlimit(-1.0f, 1.0f, x);
+  return (16.0f * std::pow(x_limited, 5) - 20.0f * std::pow(x_limited, 3) +
+          5.0f * x_limited) *
+         (0.5f + shape * 0.5f);
+}
+
+inline float logSat(float x, float shape) {
+  return signOf(x) * std::log(1.0f + (10.0f + shape * 50.0f) * std::abs(x)) /
+         std::log(11.0f + shape * 50.0f);
+}
+
+inline float halfWave(float x, float shape) {
+  return x > 0.0f ? std::tanh(x * (1.0f + shape)) : x;
+}
+
+inline float cubic(float x, float shape) {
+  float x_scaled = x * (1.0f + shape);
+  return x_scaled - (1.0f / 3.0f) * x_scaled * x_scaled * x_scaled;
+}
+
+inline float octaverSat(float x, float shape) {
+  return (std::abs(x) * 2.0f - 1.0f) * (0.5f + shape * 0.5f);
+}
+
+// === TUBE TYPES (28-33) - Inspired by Decapitator ===
+// Triode - Classic 12AX7 warmth
+inline float triode(float x, float shape) {
+  float mu = 100.0f; // Amplification factor
+  float kp = 1.2f + shape * 0.8f;
+  float vg = x * (1.0f + shape);
+  return (vg > 0.0f) ? std::tanh(vg / kp) * kp
+                     : vg / (1.0f + std::abs(vg) * mu * 0.01f);
+}
+
+// Pentode - EL34 power tube push
+inline float pentode(float x, float shape) {
+  float screen = 0.7f + shape * 0.3f;
+  float plate = x * (1.5f + shape);
+  return std::tanh(plate * screen) + 0.1f * std::sin(plate * 3.0f) * shape;
+}
+
+// Class A - Single-ended warmth
+inline float classA(float x, float shape) {
+  float bias = 0.3f * shape;
+  float biased = x + bias;
+  return std::tanh(biased * (1.0f + shape)) - bias * 0.5f;
+}
+
+// Class AB - Push-pull punch
+inline float classAB(float x, float shape) {
+  float threshold = 0.3f - shape * 0.2f;
+  if (std::abs(x) < threshold)
+    return x * (1.0f + shape * 2.0f);
+  return signOf(x) * (threshold + std::tanh((std::abs(x) - threshold) *
+                                            (2.0f + shape * 3.0f)));
+}
+
+// Class B - Crossover distortion
+inline float classB(float x, float shape) {
+  float deadzone = 0.05f + shape * 0.1f;
+  if (std::abs(x) < deadzone)
+    return 0.0f;
+  return signOf(x) *
+         std::tanh((std::abs(x) - deadzone) * (1.0f + shape * 3.0f));
+}
+
+// Germanium - Vintage transistor fuzz
+inline float germanium(float x, float shape) {
+  float temp = 0.8f + shape * 0.4f; // Temperature coefficient
+  float biased = x + 0.1f * shape;
+  float output = signOf(biased) * (1.0f - std::exp(-std::abs(biased) * temp *
+                                                   5.0f));
+  output *= 0.9f + 0.1f * shape;
+  return output;
+}
+
+// === TAPE MODES (34-38) - Inspired by Saturn ===
+// Tape 15ips - Fast tape, bright
+inline float tape15ips(float x, float shape) {
+  float headroom = 1.2f - shape * 0.3f;
+  float compression = std::tanh(x / headroom) * headroom;
+  return compression + 0.05f * x * shape; // Some HF retention
+}
+
+// Tape 7.5ips - Slow tape, warm
+inline float tape7ips(float x, float shape) {
+  float satPoint = 0.6f + shape * 0.3f;
+  float warmth = x + 0.15f * x * x * (x > 0.0f ? 1.0f : -1.0f);
+  return std::tanh(warmth / satPoint) * satPoint;
+}
+
+// Tape Cassette - Lo-fi cassette
+inline float tapeCassette(float x, float shape) {
+  float hfLoss = 1.0f - shape * 0.4f;
+  float saturated = std::tanh(x * (1.0f + shape * 2.0f));
+  return saturated * hfLoss + x * (1.0f - hfLoss) * 0.5f;
+}
+
+// Tape 456 - Ampex 456 style (famous for punchy low end)
+inline float tape456(float x, float shape) {
+  float hysteresis = x + 0.2f * x * std::abs(x) * shape;
+  return std::tanh(hysteresis * (1.0f + shape * 0.5f));
+}
+
+// Tape SM900 - Modern tape emulation
+inline float tapeSM900(float x, float shape) {
+  float modern = std::tanh(x * 1.1f);
+  float vintage = x / (1.0f + std::abs(x) * 0.5f);
+  return modern * (1.0f - shape) + vintage * shape;
+}
+
+// === TRANSFORMER (39-42) ===
+// Transformer - Iron saturation
+inline float transformer(float x, float shape) {
+  float iron = x + 0.3f * std::sin(x * 2.0f) * shape;
+  return std::tanh(iron * (1.0f + shape));
+}
+
+// Console - Neve-style console
+inline float console(float x, float shape) {
+  float harmonic2 = 0.1f * x * std::abs(x) * shape;
+  float harmonic3 = 0.05f * x * x * x * shape;
+  return std::tanh(x + harmonic2 + harmonic3);
+}
+
+// API Style - API 2500 character (punchy)
+inline float apiStyle(float x, float shape) {
+  float punch = x * (1.0f + shape * 0.5f);
+  float clipped = juce::jlimit(-1.0f, 1.0f, punch * 1.5f);
+  float output = punch * (1.0f - shape * 0.5f) + clipped * shape * 0.5f;
+  return std::tanh(output);
+}
+
+// SSL Style - SSL G-Series (clean but present)
+inline float sslStyle(float x, float shape) {
+  float compressed = x / (1.0f + std::abs(x) * shape * 0.5f);
+  float harmonic = 0.05f * x * x * x * shape;
+  return compressed + harmonic;
+}
+
+// === TRANSISTOR (43-47) ===
+// Silicon - Modern transistor
+inline float silicon(float x, float shape) {
+  float gain = 1.0f + shape * 3.0f;
+  float clipPoint = 0.8f - shape * 0.2f;
+  float output = juce::jlimit(-clipPoint, clipPoint, x * gain);
+  return std::tanh(output / clipPoint) * clipPoint;
+}
+
+// FET Clean - FET limiter style (1176 clean)
+inline float fetClean(float x, float shape) {
+  float ratio = 4.0f + shape * 16.0f;
+  float threshold = 0.5f;
+  if (std::abs(x) > threshold) {
+    float excess = std::abs(x) - threshold;
+    return signOf(x) * (threshold + excess / ratio);
+  }
+  return x;
+}
+
+// FET Dirty - FET pushed hard (1176 all-buttons)
+inline float fetDirty(float x, float shape) {
+  float attack = x * (2.0f + shape * 4.0f);
+  float output = std::tanh(attack) * (0.8f + shape * 0.2f);
+  output += 0.1f * std::sin(x * 5.0f) * shape; // Harmonics
+  return output;
+}
+
+// OpAmp - IC distortion
+inline float opAmp(float x, float shape) {
+  float gain = 1.0f + shape * 10.0f;
+  float clipped = juce::jlimit(-1.0f, 1.0f, x * gain);
+  return clipped * (1.0f - shape * 0.3f) + std::tanh(x * gain) * shape * 0.3f;
+}
+
+// CMOS - Digital/analog hybrid
+inline float cmos(float x, float shape) {
+  float digital = signOf(x) * std::pow(std::abs(x), 0.5f);
+  float analog = std::tanh(x * (1.0f + shape));
+  return digital * shape + analog * (1.0f - shape);
+}
+
+// === CREATIVE (48-52) - Inspired by Trash 2 ===
+// Scream - Aggressive screamer
+inline float scream(float x, float shape) {
+  float driven = x * (3.0f + shape * 7.0f);
+  float output = std::tanh(driven) + 0.2f * std::sin(driven * 3.0f) * shape;
+  return juce::jlimit(-1.0f, 1.0f, output);
+}
+
+// Buzz - Buzzy distortion
+inline float buzz(float x, float shape) {
+  float buzzed = x + 0.3f * std::sin(x * 10.0f * (1.0f + shape * 5.0f));
+  return std::tanh(buzzed * (1.0f + shape));
+}
+
+// Crackle - Subtle noise/crackle character
+inline float crackle(float x, float shape) {
+  float noise = (static_cast<float>(rand()) / RAND_MAX - 0.5f) * 0.02f * shape;
+  return std::tanh(x * (1.0f + shape * 2.0f)) + noise * std::abs(x);
+}
+
+// Wrap - Wrap-around distortion
+inline float wrap(float x, float shape) {
+  float wrapped = x * (1.0f + shape * 3.0f);
+  return std::fmod(wrapped + 3.0f, 2.0f) - 1.0f;
+}
+
+// Density - Thick density
+inline float density(float x, float shape) {
+  float thick = std::tanh(x * 2.0f) + std::tanh(x * 0.5f);
+  return thick * 0.5f * (1.0f + shape * 0.5f);
+}
+
+// === MATH/EXOTIC (53-57) ===
+// Cheby 7 - 7th order Chebyshev
+inline float cheby7(float x, float shape) {
+  float xl = juce::jlimit(-1.0f, 1.0f, x);
+  float x2 = xl * xl;
+  float x3 = x2 * xl;
+  float x5 = x3 * x2;
+  float x7 = x5 * x2;
+  return (64.0f * x7 - 112.0f * x5 + 56.0f * x3 - 7.0f * xl) *
+         (0.3f + shape * 0.7f);
+}
+
+// Hyperbolic - sinh based
+inline float hyperbolic(float x, float shape) {
+  float scale = 0.5f + shape * 1.5f;
+  return std::sinh(x * scale) / std::cosh(x * scale * 2.0f);
+}
+
+// Exponential - exp based limiting
+inline float exponential(float x, float shape) {
+  float sign = x > 0.0f ? 1.0f : -1.0f;
+  float absX = std::abs(x);
+  float rate = 2.0f + shape * 4.0f;
+  return sign * (1.0f - std::exp(-absX * rate));
+}
+
+// Parabolic - Parabolic curve
+inline float parabolic(float x, float shape) {
+  float scaled = x * (1.0f + shape * 2.0f);
+  if (std::abs(scaled) < 1.0f)
+    return scaled - (scaled * scaled * scaled) / 3.0f;
+  return signOf(scaled) * (2.0f / 3.0f);
+}
+
+// Wavelet - Wavelet-inspired (Mexican hat)
+inline float wavelet(float x, float shape) {
+  float t = x * (2.0f + shape * 4.0f);
+  float t2 = t * t;
+  float output = (1.0f - t2) * std::exp(-t2 * 0.5f);
+  output *= (1.0f + shape);
+  return output;
+}
+
+// Used for out-of-range indices
+inline float fallback(float x, float) { return std::tanh(x); }
+
+//==============================================================================
+// Turns a curve into a block kernel. The curve is a template argument, so it
+// is inlined into the loop instead of being called through a pointer.
+template <float (*Curve)(float, float)>
+void runKernel(float *data, int numSamples, float drive, float shape) {
+  for (int i = 0; i < numSamples; ++i)
+    data[i] = Curve(data[i] * drive, shape);
+}
+
+struct Entry {
+  Waveshapers::BlockKernel kernel;
+  Waveshapers::SampleFunction sample;
+};
+
+template <float (*Curve)(float, float)> constexpr Entry makeEntry() {
+  return {&runKernel<Curve>, Curve};
+}
+
+// Order MUST match the "waveshape" StringArray in createParameterLayout()
+constexpr std::array<Entry, Waveshapers::numWaveshapes> entries{{
+    makeEntry<tube>(),         // 0
+    makeEntry<softClip>(),     // 1
+    makeEntry<hardClip>(),     // 2
+    makeEntry<diode1>(),       // 3
+    makeEntry<diode2>(),       // 4
+    makeEntry<linearFold>(),   // 5
+    makeEntry<sinFold>(),      // 6
+    makeEntry<zeroSquare>(),   // 7
+    makeEntry<downsample>(),   // 8
+    makeEntry<asym>(),         // 9
+    makeEntry<rectify>(),      // 10
+    makeEntry<xShaper>(),      // 11
+    makeEntry<xShaperAsym>(),  // 12
+    makeEntry<sineShaper>(),   // 13
+    makeEntry<stompBox>(),     // 14
+    makeEntry<tapeSat>(),      // 15
+    makeEntry<overdrive>(),    // 16
+    makeEntry<softSat>(),      // 17
+    makeEntry<bitCrush>(),     // 18
+    makeEntry<glitchFold>(),   // 19
+    makeEntry<valve>(),        // 20
+    makeEntry<fuzzFac>(),      // 21
+    makeEntry<cheby3>(),       // 22
+    makeEntry<cheby5>(),       // 23
+    makeEntry<logSat>(),       // 24
+    makeEntry<halfWave>(),     // 25
+    makeEntry<cubic>(),        // 26
+    makeEntry<octaverSat>(),   // 27
+    makeEntry<triode>(),       // 28
+    makeEntry<pentode>(),      // 29
+    makeEntry<classA>(),       // 30
+    makeEntry<classAB>(),      // 31
+    makeEntry<classB>(),       // 32
+    makeEntry<germanium>(),    // 33
+    makeEntry<tape15ips>(),    // 34
+    makeEntry<tape7ips>(),     // 35
+    makeEntry<tapeCassette>(), // 36
+    makeEntry<tape456>(),      // 37
+    makeEntry<tapeSM900>(),    // 38
+    makeEntry<transformer>(),  // 39
+    makeEntry<console>(),      // 40
+    makeEntry<apiStyle>(),     // 41
+    makeEntry<sslStyle>(),     // 42
+    makeEntry<silicon>(),      // 43
+    makeEntry<fetClean>(),     // 44
+    makeEntry<fetDirty>(),     // 45
+    makeEntry<opAmp>(),        // 46
+    makeEntry<cmos>(),         // 47
+    makeEntry<scream>(),       // 48
+    makeEntry<buzz>(),         // 49
+    makeEntry<crackle>(),      // 50
+    makeEntry<wrap>(),         // 51
+    makeEntry<density>(),      // 52
+    makeEntry<cheby7>(),       // 53
+    makeEntry<hyperbolic>(),   // 54
+    makeEntry<exponential>(),  // 55
+    makeEntry<parabolic>(),    // 56
+    makeEntry<wavelet>(),      // 57
+}};
+
+constexpr Entry fallbackEntry = makeEntry<fallback>();
+
+const Entry &entryFor(int waveshapeIndex) {
+  if (waveshapeIndex < 0 || waveshapeIndex >= Waveshapers::numWaveshapes)
+    return fallbackEntry;
+  return entries[static_cast<size_t>(waveshapeIndex)];
+}
+} // namespace
+
+namespace Waveshapers {
+
+BlockKernel getBlockKernel(int waveshapeIndex) {
+  return entryFor(waveshapeIndex).kernel;
+}
+
+SampleFunction getSampleFunction(int waveshapeIndex) {
+  return entryFor(waveshapeIndex).sample;
+}
+
+// Every curve above the criterion of Waveshapers.h, with the measured share
+// of the power above the 16th harmonic. The closest ones left out are
+// X-Shaper (Asym) -43.3 dB, Diode 1 -43.0 dB, Stomp Box -42.1 dB and
+// Diode 2 -41.7 dB. Crackle's noise (-46.7 dB) is white at any rate, so
+// oversampling would not help it anyway.
+bool isWideband(int waveshapeIndex) {
+  switch (waveshapeIndex) {
+  case 2:  // HardClip      -34.3 dB
+  case 5:  // Linear Fold   -10.5 dB
+  case 6:  // Sin Fold      -33.4 dB
+  case 9:  // Asym          -36.6 dB
+  case 10: // Rectify       -35.4 dB
+  case 16: // Overdrive     -32.8 dB
+  case 18: // Bit-Crush     -38.6 dB
+  case 21: // Fuzz Fac      -30.4 dB
+  case 22: // Cheby 3       -24.0 dB
+  case 23: // Cheby 5       -14.6 dB
+  case 24: // Log Sat       -29.7 dB
+  case 27: // Octaver Sat   -35.4 dB
+  case 31: // Class AB      -32.9 dB
+  case 32: // Class B       -30.9 dB
+  case 33: // Germanium     -32.9 dB
+  case 43: // Silicon       -30.1 dB
+  case 44: // FET Clean     -36.3 dB
+  case 45: // FET Dirty     -35.0 dB
+  case 46: // OpAmp         -24.5 dB
+  case 47: // CMOS          -38.1 dB
+  case 48: // Scream        -23.7 dB
+  case 49: // Buzz          -17.4 dB
+  case 51: // Wrap          -13.7 dB
+  case 53: // Cheby 7        -7.7 dB
+  case 54: // Hyperbolic    -38.7 dB
+  case 55: // Exponential   -35.8 dB
+  case 57: // Wavelet       -10.0 dB
+    return true;
+  default:
+    return false;
+  }
+}
+
+} // namespace Waveshapers
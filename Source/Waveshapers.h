@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    Waveshapers.h
+    -------------
+    This file declares the saturation curves ("waveshapes").
+
+    Role:
+    Every entry of the "waveshape" choice parameter has its own block
+    kernel. The processor picks the kernel ONCE per block and runs it over
+    a whole channel, so each curve is compiled into its own tight loop
+    (inlined, and vectorized where the curve allows it) instead of going
+    through a 58-case switch for every oversampled sample.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace Waveshapers {
+
+// Number of entries in the "waveshape" choice parameter
+constexpr int numWaveshapes = 58;
+
+// Crackle adds random noise on every call, so it is never vectorized or
+// baked into a lookup table.
+constexpr int crackleIndex = 50;
+
+// Applies the drive gain then the curve to a whole channel, in place.
+using BlockKernel = void (*)(float *data, int numSamples, float drive,
+                             float shape);
+
+// Applies the curve to a single (already driven) sample.
+using SampleFunction = float (*)(float x, float shape);
+
+// Returns the kernel for a waveshape index. Out-of-range indices fall back
+// to a plain tanh curve.
+BlockKernel getBlockKernel(int waveshapeIndex);
+
+// Returns the single-sample curve for a waveshape index (same fallback).
+SampleFunction getSampleFunction(int waveshapeIndex);
+
+// True for the curves whose harmonics reach far up. The "Auto" oversampling
+// gives them twice the oversampled rate of the smooth curves.
+//
+// Criterion: a full-scale sine driven by widebandDrive (+6 dB, shape
+// widebandShape) puts more than widebandThresholdDb of the output power
+// into the harmonics above the widebandHarmonic-th. For a 5 kHz tone those
+// are the harmonics above 80 kHz, which alias back at autoOversampledRate
+// (PluginProcessor.h). "steverator_bench --shaper" measures every curve and
+// fails if this list disagrees.
+constexpr float widebandDrive = 2.0f;
+constexpr float widebandShape = 0.5f;
+constexpr int widebandHarmonic = 16;
+constexpr double widebandThresholdDb = -40.0;
+
+bool isWideband(int waveshapeIndex);
+
+} // namespace Waveshapers
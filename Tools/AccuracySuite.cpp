@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    AccuracySuite.cpp
+    -----------------
+    "steverator_bench --accuracy"
+
+    Role:
+    1. Checks every FastMath function and tier against the standard library
+       (in double precision) and fails if an error exceeds the documented
+       bound from FastMath::getErrorBounds().
+    2. Checks every SIMD kernel table against the scalar table of the same
+       tier. For High and Eco both run the same polynomials and only differ
+       by rounding. For Exact the scalar table is the std:: code, so the
+       SIMD kernels differ by the polynomial error as well (about 1e-5,
+       bounded by FastMath::exactKernelDeviation).
+    3. Reports how far each tier moves the waveshapes away from Exact.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "FastMath.h"
+#include "SimdWaveshapers.h"
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace BenchSuites {
+
+namespace {
+
+// High and Eco: vector and scalar code only differ by rounding (FMA,
+// operation order). Exact: the scalar kernels are std::, the vector ones
+// Cephes polynomials (FastMath::exactKernelDeviation).
+constexpr double maxSimdDeviation = 5.0e-5;
+
+double getMaxSimdDeviation(FastMath::Tier tier) {
+  return tier == FastMath::Tier::Exact ? FastMath::exactKernelDeviation
+                                       : maxSimdDeviation;
+}
+
+std::vector<float> sweep(double lo, double hi, int numPoints, bool logScale) {
+  std::vector<float> points;
+  points.reserve(static_cast<size_t>(numPoints));
+  for (int i = 0; i < numPoints; ++i) {
+    const double t = (double)i / (numPoints - 1);
+    points.push_back(
+        (float)(logScale ? lo * std::pow(hi / lo, t) : lo + (hi - lo) * t));
+  }
+  return points;
+}
+
+struct FunctionCheck {
+  const char *name;
+  double bound;
+  double error;
+};
+
+template <FastMath::Tier T> std::vector<FunctionCheck> checkFunctions() {
+  using V = FastMath::Vec<FastMath::ScalarOps, T>;
+  constexpr auto bounds = FastMath::getErrorBounds(T);
+
+  auto absolute = [](float approx, double exact) {
+    return std::abs((double)approx - exact);
+  };
+  auto relative = [](float approx, double exact) {
+    return std::abs((double)approx - exact) /
+           juce::jmax(1.0e-30, std::abs(exact));
+  };
+
+  auto maxError = [](const std::vector<float> &xs,
+                     const std::function<double(float)> &errorAt) {
+    double worst = 0.0;
+    for (auto x : xs)
+      worst = juce::jmax(worst, errorAt(x));
+    return worst;
+  };
+
+  std::vector<FunctionCheck> checks;
+
+  checks.push_back({"exp", bounds.exp,
+                    maxError(sweep(-87.0, 88.0, 400001, false), [&](float x) {
+                      return relative(FastMath::exp(V{x}).v, std::exp((double)x));
+                    })});
+
+  checks.push_back({"tanh", bounds.tanh,
+                    maxError(sweep(-20.0, 20.0, 400001, false), [&](float x) {
+                      return absolute(FastMath::tanh(V{x}).v, std::tanh((double)x));
+                    })});
+
+  checks.push_back({"sin", bounds.sin,
+                    maxError(sweep(-1.0e4, 1.0e4, 800001, false), [&](float x) {
+                      return absolute(FastMath::sin(V{x}).v, std::sin((double)x));
+                    })});
+
+  checks.push_back({"atan", bounds.atan,
+                    maxError(sweep(-1.0e3, 1.0e3, 400001, false), [&](float x) {
+                      return absolute(FastMath::atan(V{x}).v, std::atan((double)x));
+                    })});
+
+  checks.push_back({"log", bounds.log,
+                    maxError(sweep(1.0e-3, 1.0e4, 400001, true), [&](float x) {
+                      return absolute(FastMath::log(V{x}).v, std::log((double)x));
+                    })});
+
+  const auto exponents = sweep(0.1, 4.0, 101, false);
+  checks.push_back({"pow", bounds.pow,
+                    maxError(sweep(1.0e-3, 1.0e3, 2001, true), [&](float x) {
+                      double worst = 0.0;
+                      for (auto y : exponents)
+                        worst = juce::jmax(
+                            worst, relative(FastMath::pow(V{x}, V{y}).v,
+                                            std::pow((double)x, (double)y)));
+                      return worst;
+                    })});
+
+  // sinh is measured relative to max(1, |sinh|): near zero it is a
+  // difference of two exponentials, like the curves that use it.
+  checks.push_back(
+      {"sinh", bounds.sinhCosh,
+       maxError(sweep(-20.0, 20.0, 200001, false), [&](float x) {
+         const double exact = std::sinh((double)x);
+         return absolute(FastMath::sinh(V{x}).v, exact) /
+                juce::jmax(1.0, std::abs(exact));
+       })});
+
+  checks.push_back({"cosh", bounds.sinhCosh,
+                    maxError(sweep(-20.0, 20.0, 200001, false), [&](float x) {
+                      return relative(FastMath::cosh(V{x}).v, std::cosh((double)x));
+                    })});
+
+  return checks;
+}
+
+// Largest |a - b| / max(1, |a|) between two kernels, over the drive and
+// shape range a session can reach.
+double compareKernels(Waveshapers::BlockKernel reference,
+                      Waveshapers::BlockKernel candidate) {
+  const auto input = sweep(-3.0, 3.0, 1003, false);
+  std::vector<float> a(input.size()), b(input.size());
+  double worst = 0.0;
+
+  for (float drive : {1.0f, 4.0f, 16.0f}) {
+    for (float shape : {0.0f, 0.3f, 0.7f, 1.0f}) {
+      a = input;
+      b = input;
+      reference(a.data(), (int)a.size(), drive, shape);
+      candidate(b.data(), (int)b.size(), drive, shape);
+      for (size_t i = 0; i < a.size(); ++i)
+        worst = juce::jmax(worst, std::abs((double)a[i] - b[i]) /
+                                      juce::jmax(1.0, std::abs((double)a[i])));
+    }
+  }
+  return worst;
+}
+
+} // namespace
+
+void runAccuracySuite(const juce::ArgumentList &args) {
+  juce::ignoreUnused(args);
+  using SimdWaveshapers::Isa;
+  bool passed = true;
+
+  std::cout << "FastMath error vs std:: (max error / documented bound)\n";
+  std::cout << juce::String("function").paddedRight(' ', 10);
+  for (int t = 0; t < FastMath::numTiers; ++t)
+    std::cout << juce::String(FastMath::getTierName((FastMath::Tier)t))
+                     .paddedLeft(' ', 24);
+  std::cout << "\n";
+
+  const std::vector<FunctionCheck> results[] = {
+      checkFunctions<FastMath::Tier::Exact>(),
+      checkFunctions<FastMath::Tier::High>(),
+      checkFunctions<FastMath::Tier::Eco>()};
+
+  for (size_t f = 0; f < results[0].size(); ++f) {
+    std::cout << juce::String(results[0][f].name).paddedRight(' ', 10);
+    for (const auto &tierResults : results) {
+      const auto &check = tierResults[f];
+      const bool ok = check.error <= check.bound;
+      passed = passed && ok;
+      std::cout << (juce::String::formatted("%.2e / %.1e", check.error,
+                                            check.bound) +
+                    (ok ? "  " : " !"))
+                       .paddedLeft(' ', 24);
+    }
+    std::cout << "\n";
+  }
+
+  std::cout << "\nSIMD kernels vs scalar kernels of the same tier "
+               "(max deviation; limit "
+            << FastMath::exactKernelDeviation
+            << " for Exact, whose scalar kernels are std::, "
+            << maxSimdDeviation << " otherwise)\n";
+  for (auto isa : {Isa::SSE2, Isa::NEON, Isa::AVX2, Isa::AVX512}) {
+    if (!SimdWaveshapers::isIsaAvailable(isa))
+      continue;
+
+    std::cout << juce::String(SimdWaveshapers::getIsaName(isa))
+                     .paddedRight(' ', 10);
+    for (int t = 0; t < FastMath::numTiers; ++t) {
+      const auto tier = static_cast<FastMath::Tier>(t);
+      const auto &scalar =
+          SimdWaveshapers::getKernelTable(Isa::Scalar, tier);
+      const auto &simd = SimdWaveshapers::getKernelTable(isa, tier);
+
+      double worst = 0.0;
+      int worstShape = 0;
+      for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+        if (shape == Waveshapers::crackleIndex)
+          continue;
+        const double error = compareKernels(scalar[(size_t)shape],
+                                            simd[(size_t)shape]);
+        if (error > worst) {
+          worst = error;
+          worstShape = shape;
+        }
+      }
+
+      const bool ok = worst <= getMaxSimdDeviation(tier);
+      passed = passed && ok;
+      std::cout << (juce::String::formatted("%s %.2e (shape %d)",
+                                            FastMath::getTierName(tier), worst,
+                                            worstShape) +
+                    (ok ? "  " : " !"))
+                       .paddedLeft(' ', 30);
+    }
+    std::cout << "\n";
+  }
+
+  std::cout << "\nWaveshape deviation from the Exact tier (informative)\n";
+  for (auto tier : {FastMath::Tier::High, FastMath::Tier::Eco}) {
+    const auto &exact =
+        SimdWaveshapers::getKernelTable(Isa::Scalar, FastMath::Tier::Exact);
+    const auto &approx = SimdWaveshapers::getKernelTable(Isa::Scalar, tier);
+
+    double worst = 0.0;
+    int worstShape = 0;
+    for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+      if (shape == Waveshapers::crackleIndex)
+        continue;
+      const double error =
+          compareKernels(exact[(size_t)shape], approx[(size_t)shape]);
+      if (error > worst) {
+        worst = error;
+        worstShape = shape;
+      }
+    }
+    std::cout << juce::String(FastMath::getTierName(tier)).paddedRight(' ', 10)
+              << juce::String::formatted("%.2e (%.1f dB, shape %d)", worst,
+                                         juce::Decibels::gainToDecibels(worst),
+                                         worstShape)
+              << "\n";
+  }
+  std::cout << std::endl;
+
+  if (!passed)
+    juce::ConsoleApplication::fail("Accuracy check failed", 1);
+}
+
+} // namespace BenchSuites
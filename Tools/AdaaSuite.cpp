@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+    AdaaSuite.cpp
+    -------------
+    "steverator_bench --adaa"
+
+    Role:
+    Compares the aliasing and the CPU cost of ADAA mode at 2x against the
+    plain curves at 4x (the Direct mode default), through the same
+    half-band IIR oversamplers as the plugin.
+
+    Aliasing: a sine whose frequency falls exactly on a DFT bin is driven
+    into the curve. Once the filters have settled the output repeats every
+    N samples, so every harmonic lands on a multiple of that bin and all
+    the remaining power is aliasing (plus float rounding, ~-140 dB). The
+    report shows that power relative to the harmonics, for the worst of
+    two test tones.
+
+  ==============================================================================
+*/
+
+#include "Adaa.h"
+#include "BenchSuites.h"
+#include "SimdWaveshapers.h"
+#include "WaveshaperTable.h"
+#include <array>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int analysisLength = 16384;
+constexpr int settleLength = 8192;
+constexpr int blockSize = 512;
+
+// 1709 and 3761 are prime, so no aliased harmonic ever lands on a harmonic
+// bin (~5 kHz and ~11 kHz at 48 kHz)
+constexpr int toneBins[] = {1709, 3761};
+
+struct Config {
+  const char *name;
+  int oversamplingStages; // log2 of the factor
+  bool adaa;
+};
+
+constexpr Config configs[] = {{"Plain 4x", 2, false},
+                              {"Plain 2x", 1, false},
+                              {"ADAA 2x", 1, true},
+                              {"ADAA 1x", 0, true}};
+
+// One shaper path: oversampler + curve, stereo, block by block
+class ShaperPath {
+public:
+  ShaperPath(const Config &c, int waveshapeIndex, float driveGain,
+             WaveshaperTable &tableToUse)
+      : config(c), index(waveshapeIndex), drive(driveGain),
+        table(tableToUse),
+        kernel(SimdWaveshapers::getKernelTable(
+            SimdWaveshapers::getBestIsa())[(size_t)waveshapeIndex]) {
+    if (config.oversamplingStages > 0) {
+      oversampling = std::make_unique<juce::dsp::Oversampling<float>>(
+          2, config.oversamplingStages,
+          juce::dsp::Oversampling<float>::FilterType::
+              filterHalfBandPolyphaseIIR);
+      oversampling->initProcessing(blockSize);
+    }
+  }
+
+  void process(juce::AudioBuffer<float> &buffer) {
+    juce::dsp::AudioBlock<float> block(buffer);
+    auto upsampled =
+        oversampling != nullptr ? oversampling->processSamplesUp(block) : block;
+    const int numSamples = (int)upsampled.getNumSamples();
+
+    const bool closedForm = config.adaa && Adaa::hasClosedForm(index);
+    if (config.adaa && !closedForm)
+      table.beginBlock(index, shape);
+
+    for (int channel = 0; channel < (int)upsampled.getNumChannels();
+         ++channel) {
+      auto *data = upsampled.getChannelPointer(channel);
+      if (closedForm)
+        Adaa::processClosedForm(index, data, numSamples, drive, shape,
+                                states[(size_t)channel]);
+      else if (config.adaa)
+        table.processChannelAdaa(data, numSamples, drive,
+                                 states[(size_t)channel]);
+      else
+        kernel(data, numSamples, drive, shape);
+    }
+    if (config.adaa && !closedForm)
+      table.endBlock(numSamples);
+
+    if (oversampling != nullptr)
+      oversampling->processSamplesDown(block);
+  }
+
+  static constexpr float shape = 0.5f;
+
+private:
+  const Config &config;
+  const int index;
+  const float drive;
+  WaveshaperTable &table;
+  const Waveshapers::BlockKernel kernel;
+  std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+  std::array<Adaa::ChannelState, 2> states;
+};
+
+// Makes sure the table for this waveshape is built and faded in
+void waitForTable(WaveshaperTable &table, int waveshapeIndex) {
+  if (Adaa::hasClosedForm(waveshapeIndex))
+    return;
+  while (!table.beginBlock(waveshapeIndex, ShaperPath::shape))
+    juce::Thread::sleep(1);
+  for (int i = 0; i < 50; ++i) {
+    juce::Thread::sleep(1);
+    table.beginBlock(waveshapeIndex, ShaperPath::shape);
+    table.endBlock(1 << 20);
+  }
+}
+
+// Alias power relative to the harmonics of the tone, in dB
+double measureAliasing(const Config &config, int waveshapeIndex,
+                       float driveGain, WaveshaperTable &table, int bin) {
+  ShaperPath path(config, waveshapeIndex, driveGain, table);
+  juce::AudioBuffer<float> buffer(2, blockSize);
+  std::vector<double> output;
+  output.reserve((size_t)(settleLength + analysisLength));
+
+  const double phaseStep = juce::MathConstants<double>::twoPi * bin /
+                           (double)analysisLength;
+  for (int start = 0; start < settleLength + analysisLength;
+       start += blockSize) {
+    for (int i = 0; i < blockSize; ++i) {
+      const float x = 0.5f * (float)std::sin(phaseStep * (start + i));
+      buffer.setSample(0, i, x);
+      buffer.setSample(1, i, x);
+    }
+    path.process(buffer);
+    for (int i = 0; i < blockSize; ++i)
+      output.push_back(buffer.getSample(0, i));
+  }
+
+  const double *x = output.data() + settleLength;
+  double total = 0.0;
+  for (int n = 0; n < analysisLength; ++n)
+    total += x[n] * x[n];
+
+  // Parseval: bin k (0 < k < N/2) holds 2|X_k|^2 / N of the energy
+  double harmonics = 0.0;
+  for (int k = 0; k < analysisLength / 2; k += bin) {
+    double re = 0.0, im = 0.0;
+    for (int n = 0; n < analysisLength; ++n) {
+      const double phase = juce::MathConstants<double>::twoPi *
+                           (double)(((juce::int64)k * n) % analysisLength) /
+                           analysisLength;
+      re += x[n] * std::cos(phase);
+      im -= x[n] * std::sin(phase);
+    }
+    harmonics += (k == 0 ? 1.0 : 2.0) * (re * re + im * im) / analysisLength;
+  }
+
+  const double aliasing = juce::jmax(total - harmonics, 1.0e-30);
+  return 10.0 * std::log10(aliasing / juce::jmax(harmonics, 1.0e-30));
+}
+
+// Nanoseconds per stereo input sample for up + curve + down
+double measureCost(const Config &config, int waveshapeIndex, float driveGain,
+                   WaveshaperTable &table, int numRepeats) {
+  ShaperPath path(config, waveshapeIndex, driveGain, table);
+  juce::AudioBuffer<float> buffer(2, blockSize);
+  juce::Random random(0x5eed);
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r) {
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < blockSize; ++i)
+        buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    path.process(buffer);
+    ticks += juce::Time::getHighResolutionTicks() - start;
+  }
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)numRepeats * blockSize);
+}
+
+} // namespace
+
+void runAdaaSuite(const juce::ArgumentList &args) {
+  const int numRepeats = getIntOption(args, "--repeats", 200);
+  const float driveDb = (float)getIntOption(args, "--drive", 12);
+  const float driveGain = juce::Decibels::decibelsToGain(driveDb);
+
+  // Closed-form antiderivatives first, then tabulated ones
+  const std::pair<int, const char *> shapes[] = {
+      {1, "Soft Clip"},  {2, "Hard Clip"}, {16, "Overdrive"},
+      {20, "Valve"},     {39, "Transformer"}, {47, "CMOS"}};
+
+  WaveshaperTable table;
+  table.prepare(sampleRate * 2.0);
+
+  std::cout << "ADAA vs plain oversampling (drive +" << driveDb
+            << " dB, shape " << ShaperPath::shape << ", " << sampleRate
+            << " Hz)\n"
+            << "Aliasing: power outside the harmonics, dB below them (worst of "
+               "~5 and ~11 kHz)\n"
+            << "CPU: ns per stereo sample for upsampling + curve + "
+               "downsampling\n\n";
+
+  std::cout << juce::String("shape").paddedRight(' ', 20);
+  for (const auto &config : configs)
+    std::cout << juce::String(config.name).paddedLeft(' ', 20);
+  std::cout << "\n";
+
+  for (const auto &[index, name] : shapes) {
+    waitForTable(table, index);
+    std::cout << (juce::String(name) + " (" + juce::String(index) + ")")
+                     .paddedRight(' ', 20);
+
+    for (const auto &config : configs) {
+      double worst = -1000.0;
+      for (int bin : toneBins)
+        worst = juce::jmax(
+            worst, measureAliasing(config, index, driveGain, table, bin));
+      const double cost =
+          measureCost(config, index, driveGain, table, numRepeats);
+      std::cout << juce::String::formatted("%6.1f dB %5.1f ns", worst, cost)
+                       .paddedLeft(' ', 20);
+    }
+    std::cout << "\n";
+  }
+  std::cout << std::endl;
+}
+
+} // namespace BenchSuites
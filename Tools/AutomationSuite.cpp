@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    AutomationSuite.cpp
+    -------------------
+    "steverator_bench --automation"
+
+    Role:
+    Reports what the "Automation Resolution" parameter costs: with it,
+    processBlock() splits each block into sub-blocks of 16 to 128 samples
+    and reads the parameters again before each one. For a few host block
+    sizes, it times processBlock() at every resolution (default settings,
+    4x oversampling, Drive automated every block) and compares it with
+    reading the parameters once per block.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "PluginProcessor.h"
+#include <iostream>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int maxBlockSize = 1024;
+constexpr int blockSizes[] = {64, 256, maxBlockSize};
+const char *const resolutionNames[] = {"Block", "16", "32", "64", "128"};
+
+// Returns ns per stereo sample
+double measure(int numSamples, int resolution, int numRepeats) {
+  Vst_saturatorAudioProcessor processor;
+  processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+  const auto set = [&processor](const char *parameterID, float value) {
+    auto *parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+  };
+  set("automationResolution", (float)resolution);
+  processor.prepareToPlay(sampleRate, maxBlockSize);
+
+  juce::AudioBuffer<float> buffer(2, numSamples);
+  juce::MidiBuffer midi;
+  juce::Random random{0x5eed};
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r) {
+    set("drive", (r % 2) == 1 ? 12.0f : 6.0f);
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < numSamples; ++i)
+        buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    processor.processBlock(buffer, midi);
+    if (r > 0) // the first block snaps the ramps
+      ticks += juce::Time::getHighResolutionTicks() - start;
+  }
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)(numRepeats - 1) * numSamples);
+}
+
+} // namespace
+
+void runAutomationSuite(const juce::ArgumentList &args) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  const int numRepeats = juce::jmax(2, getIntOption(args, "--repeats", 400));
+
+  std::cout << "Automation resolution (" << sampleRate
+            << " Hz, 4x oversampling, ns per stereo sample)\n"
+            << juce::String("block").paddedRight(' ', 8)
+            << juce::String("resolution").paddedRight(' ', 12)
+            << juce::String("cost").paddedLeft(' ', 10)
+            << juce::String("overhead").paddedLeft(' ', 10) << "\n";
+
+  for (const int numSamples : blockSizes) {
+    const double perBlock = measure(numSamples, 0, numRepeats);
+    for (int resolution = 0; resolution < 5; ++resolution) {
+      const double cost = resolution == 0
+                              ? perBlock
+                              : measure(numSamples, resolution, numRepeats);
+      std::cout << juce::String(numSamples).paddedRight(' ', 8)
+                << juce::String(resolutionNames[resolution])
+                       .paddedRight(' ', 12)
+                << juce::String(cost, 2).paddedLeft(' ', 10)
+                << (juce::String((cost / perBlock - 1.0) * 100.0, 1) + "%")
+                       .paddedLeft(' ', 10)
+                << "\n";
+    }
+  }
+  std::cout << std::endl;
+}
+
+} // namespace BenchSuites
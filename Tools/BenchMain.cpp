@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    BenchMain.cpp
+    -------------
+    Entry point of the steverator_bench command line tool.
+
+    Role:
+    Runs performance reports on the DSP code outside of a DAW, so results
+    can be compared between machines (e.g. AVX2 vs AVX-512 render nodes).
+    Each report is a command:
+
+      steverator_bench --shaper [--tier=exact|high|eco] [--samples=N]
+                       [--repeats=N]
+      steverator_bench --adaa [--drive=dB] [--repeats=N]
+      steverator_bench --oversampling [--repeats=N]
+      steverator_bench --crossover [--repeats=N]
+      steverator_bench --pipeline [--repeats=N]
+      steverator_bench --automation [--repeats=N]
+      steverator_bench --process [--seconds=N] [--format=csv|json] [--full]
+      steverator_bench --accuracy
+      steverator_bench --realtime
+
+    Running the tool without arguments runs every report.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+
+namespace BenchSuites {
+
+int getIntOption(const juce::ArgumentList &args, const juce::String &option,
+                 int defaultValue) {
+  const auto value = args.getValueForOption(option);
+  return value.isEmpty() ? defaultValue : value.getIntValue();
+}
+
+} // namespace BenchSuites
+
+int main(int argc, char *argv[]) {
+  juce::ConsoleApplication app;
+  app.addHelpCommand("--help|-h", "Usage:", false);
+
+  app.addCommand({"--shaper",
+                  "--shaper [--tier=exact|high|eco] [--samples=N] "
+                  "[--repeats=N]",
+                  "Waveshaper throughput per instruction set, Direct vs Table mode", "",
+                  BenchSuites::runShaperSuite});
+
+  app.addCommand({"--adaa", "--adaa [--drive=dB] [--repeats=N]",
+                  "Aliasing and CPU of ADAA at 2x vs plain 4x oversampling",
+                  "", BenchSuites::runAdaaSuite});
+
+  app.addCommand({"--oversampling", "--oversampling [--repeats=N]",
+                  "Latency, ripple and CPU of the oversampling filters", "",
+                  BenchSuites::runOversamplingSuite});
+
+  app.addCommand({"--crossover", "--crossover [--repeats=N]",
+                  "Fused 3-band crossover vs separate filters", "",
+                  BenchSuites::runCrossoverSuite});
+
+  app.addCommand({"--pipeline", "--pipeline [--repeats=N]",
+                  "Cost of each routing pipeline of processBlock()", "",
+                  BenchSuites::runPipelineSuite});
+
+  app.addCommand({"--automation", "--automation [--repeats=N]",
+                  "Cost of each Automation Resolution", "",
+                  BenchSuites::runAutomationSuite});
+
+  app.addCommand({"--process",
+                  "--process [--seconds=N] [--format=csv|json] [--full]",
+                  "processBlock() time per waveshape, block size, rate and "
+                  "routing (CSV or JSON)",
+                  "", BenchSuites::runProcessSuite});
+
+  app.addCommand({"--accuracy", "--accuracy",
+                  "Checks the FastMath error bounds and the SIMD kernels", "",
+                  BenchSuites::runAccuracySuite});
+
+  app.addCommand({"--realtime", "--realtime",
+                  "Checks that processBlock() never allocates memory", "",
+                  BenchSuites::runRealtimeSuite});
+
+  app.addDefaultCommand({"", "", "Runs every report", "",
+                         [](const juce::ArgumentList &args) {
+                           BenchSuites::runAccuracySuite(args);
+                           BenchSuites::runRealtimeSuite(args);
+                           BenchSuites::runShaperSuite(args);
+                           BenchSuites::runAdaaSuite(args);
+                           BenchSuites::runOversamplingSuite(args);
+                           BenchSuites::runCrossoverSuite(args);
+                           BenchSuites::runPipelineSuite(args);
+                           BenchSuites::runAutomationSuite(args);
+                           BenchSuites::runProcessSuite(args);
+                         }});
+
+  return app.findAndRunCommand(argc, argv);
+}
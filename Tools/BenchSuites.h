@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    BenchSuites.h
+    -------------
+    The reports and checks run by steverator_bench.
+
+    Role:
+    Each suite lives in its own file in Tools/ and is registered as a
+    command in BenchMain.cpp. Suites print their report to stdout; checks
+    call juce::ConsoleApplication::fail() when a limit is exceeded, so the
+    tool exits with a non-zero code (usable from CI).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace BenchSuites {
+
+// Reads "--name=value" (or "--name value") as an int, with a default.
+int getIntOption(const juce::ArgumentList &args, const juce::String &option,
+                 int defaultValue);
+
+// --shaper: waveshaper throughput per instruction set and accuracy tier,
+// plus Direct vs Table mode; fails if Waveshapers::isWideband() disagrees
+// with its measured criterion
+void runShaperSuite(const juce::ArgumentList &args);
+
+// --adaa: aliasing and CPU of ADAA at 2x vs the plain curves at 4x
+void runAdaaSuite(const juce::ArgumentList &args);
+
+// --oversampling: latency, passband ripple and CPU of the IIR and FIR
+// oversampling filters
+void runOversamplingSuite(const juce::ArgumentList &args);
+
+// --realtime: fails if processBlock() allocates or frees memory
+void runRealtimeSuite(const juce::ArgumentList &args);
+
+// --crossover: fused 3-band crossover vs the separate filters (cost and
+// agreement)
+void runCrossoverSuite(const juce::ArgumentList &args);
+
+// --pipeline: cost of each specialized routing pipeline of processBlock()
+void runPipelineSuite(const juce::ArgumentList &args);
+
+// --automation: cost of reading the parameters every 16 to 128 samples
+void runAutomationSuite(const juce::ArgumentList &args);
+
+// --process: processBlock() per waveshape, block size, rate and routing, as
+// CSV or JSON rows (ns per sample, realtime factor, p99 block time)
+void runProcessSuite(const juce::ArgumentList &args);
+
+// --accuracy: FastMath error bounds and SIMD/scalar kernel agreement
+void runAccuracySuite(const juce::ArgumentList &args);
+
+} // namespace BenchSuites
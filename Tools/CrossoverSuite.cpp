@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+    CrossoverSuite.cpp
+    ------------------
+    "steverator_bench --crossover"
+
+    Role:
+    1. Runs the fused crossover (Crossover.h) against the code it
+       replaced: four juce::dsp::LinkwitzRileyFilter passes over three
+       copies of the block, the band stages, then the sum. For each
+       combination of the Low and High band switches it reports the cost
+       of both, of the fused crossover run one channel at a time and of
+       its stereo (SIMD lanes) path, and the largest difference to the
+       separate filters; it fails if either fused version differs by more
+       than float rounding. With both bands off it also shows the allpass
+       path against the full split (the saving, and how far the allpass is
+       from the summed bands).
+    2. Switches the bands on and off every few blocks on a sine and fails
+       if the largest sample-to-sample step is more than a little above
+       the sine's own (a click).
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "Crossover.h"
+#include <iostream>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr float lowFrequency = 200.0f;
+constexpr float highFrequency = 4000.0f;
+constexpr double maxDifference = 1.0e-5;
+constexpr double maxStepRatio = 1.2;
+
+// The separate-filter version (processBands() before the fused crossover)
+class ReferenceCrossover {
+public:
+  ReferenceCrossover() {
+    using Type = juce::dsp::LinkwitzRileyFilterType;
+    lp1.setType(Type::lowpass);
+    hp1.setType(Type::highpass);
+    lp2.setType(Type::lowpass);
+    hp2.setType(Type::highpass);
+
+    const juce::dsp::ProcessSpec spec{sampleRate, (juce::uint32)blockSize, 2};
+    for (auto *filter : {&lp1, &hp1, &lp2, &hp2})
+      filter->prepare(spec);
+    lp1.setCutoffFrequency(lowFrequency);
+    hp1.setCutoffFrequency(lowFrequency);
+    lp2.setCutoffFrequency(highFrequency);
+    hp2.setCutoffFrequency(highFrequency);
+
+    for (auto *band : {&lowBuffer, &midBuffer, &highBuffer})
+      band->setSize(2, blockSize);
+  }
+
+  void process(juce::AudioBuffer<float> &audio,
+               const ThreeBandCrossover::BandSettings &settings) {
+    for (auto *band : {&lowBuffer, &midBuffer, &highBuffer})
+      for (int channel = 0; channel < 2; ++channel)
+        band->copyFrom(channel, 0, audio, channel, 0, blockSize);
+
+    juce::dsp::AudioBlock<float> lowBlock(lowBuffer);
+    lp1.process(juce::dsp::ProcessContextReplacing<float>(lowBlock));
+    juce::dsp::AudioBlock<float> highBlock(highBuffer);
+    hp2.process(juce::dsp::ProcessContextReplacing<float>(highBlock));
+    juce::dsp::AudioBlock<float> midBlock(midBuffer);
+    hp1.process(juce::dsp::ProcessContextReplacing<float>(midBlock));
+    lp2.process(juce::dsp::ProcessContextReplacing<float>(midBlock));
+
+    for (int channel = 0; channel < 2; ++channel) {
+      auto *low = lowBuffer.getWritePointer(channel);
+      auto *high = highBuffer.getWritePointer(channel);
+      for (int i = 0; i < blockSize; ++i) {
+        if (settings.lowEnable)
+          low[i] = (low[i] + (low[i] * std::abs(low[i])) * settings.lowWarmth) *
+                   settings.lowLevel;
+        if (settings.highEnable)
+          high[i] = (high[i] - settings.tanh(high[i] * settings.highSoftness)) *
+                    settings.highLevel;
+      }
+    }
+
+    audio.clear();
+    for (int channel = 0; channel < 2; ++channel) {
+      audio.addFrom(channel, 0, lowBuffer, channel, 0, blockSize);
+      audio.addFrom(channel, 0, midBuffer, channel, 0, blockSize);
+      audio.addFrom(channel, 0, highBuffer, channel, 0, blockSize);
+    }
+  }
+
+private:
+  juce::dsp::LinkwitzRileyFilter<float> lp1, hp1, lp2, hp2;
+  juce::AudioBuffer<float> lowBuffer, midBuffer, highBuffer;
+};
+
+void fillNoise(juce::AudioBuffer<float> &buffer, juce::Random &random) {
+  for (int channel = 0; channel < 2; ++channel)
+    for (int i = 0; i < blockSize; ++i)
+      buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+}
+
+double toNanoseconds(juce::int64 ticks, int numRepeats) {
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)numRepeats * blockSize);
+}
+
+} // namespace
+
+void runCrossoverSuite(const juce::ArgumentList &args) {
+  const int numRepeats = getIntOption(args, "--repeats", 2000);
+  bool passed = true;
+
+  std::cout << "3-band crossover, separate filters vs fused (" << sampleRate
+            << " Hz, " << lowFrequency << " / " << highFrequency
+            << " Hz, ns per stereo sample)\n"
+            << juce::String("bands").paddedRight(' ', 20)
+            << juce::String("separate").paddedLeft(' ', 12)
+            << juce::String("per channel").paddedLeft(' ', 13)
+            << juce::String("stereo").paddedLeft(' ', 10)
+            << juce::String("speedup").paddedLeft(' ', 10)
+            << juce::String("max diff").paddedLeft(' ', 12) << "\n";
+
+  struct Row {
+    const char *name;
+    bool lowEnable, highEnable;
+    bool neutral; // band stages that change nothing: a plain split + sum
+    bool checked;
+  };
+  const Row rows[] = {{"both off, split", true, false, true, true},
+                      {"both off, allpass", false, false, false, false},
+                      {"low on", true, false, false, true},
+                      {"high on", false, true, false, true},
+                      {"both on", true, true, false, true}};
+
+  for (const auto &row : rows) {
+    ThreeBandCrossover::BandSettings settings;
+    settings.lowEnable = row.lowEnable;
+    settings.lowWarmth = row.neutral ? 0.0f : 0.5f;
+    settings.lowLevel = juce::Decibels::decibelsToGain(row.neutral ? 0.0f : 3.0f);
+    settings.highEnable = row.highEnable;
+    settings.highSoftness = 0.5f;
+    settings.highLevel = juce::Decibels::decibelsToGain(-3.0f);
+
+    ReferenceCrossover reference;
+    ThreeBandCrossover fused;
+    fused.prepare(sampleRate);
+    fused.setCutoffs(lowFrequency, highFrequency);
+    ThreeBandCrossover perChannel[2];
+    for (auto &crossover : perChannel) {
+      crossover.prepare(sampleRate);
+      crossover.setCutoffs(lowFrequency, highFrequency);
+    }
+
+    juce::AudioBuffer<float> referenceBuffer(2, blockSize);
+    juce::AudioBuffer<float> fusedBuffer(2, blockSize);
+    juce::AudioBuffer<float> perChannelBuffer(2, blockSize);
+    juce::Random random(0x5eed);
+    juce::int64 referenceTicks = 0, fusedTicks = 0, perChannelTicks = 0;
+    double difference = 0.0;
+
+    for (int r = 0; r < numRepeats; ++r) {
+      fillNoise(referenceBuffer, random);
+      for (int channel = 0; channel < 2; ++channel) {
+        fusedBuffer.copyFrom(channel, 0, referenceBuffer, channel, 0,
+                             blockSize);
+        perChannelBuffer.copyFrom(channel, 0, referenceBuffer, channel, 0,
+                                  blockSize);
+      }
+
+      auto start = juce::Time::getHighResolutionTicks();
+      reference.process(referenceBuffer, settings);
+      referenceTicks += juce::Time::getHighResolutionTicks() - start;
+
+      start = juce::Time::getHighResolutionTicks();
+      fused.process(fusedBuffer.getArrayOfWritePointers(), 2, blockSize,
+                    settings);
+      fusedTicks += juce::Time::getHighResolutionTicks() - start;
+
+      start = juce::Time::getHighResolutionTicks();
+      for (int channel = 0; channel < 2; ++channel) {
+        float *data = perChannelBuffer.getWritePointer(channel);
+        perChannel[channel].process(&data, 1, blockSize, settings);
+      }
+      perChannelTicks += juce::Time::getHighResolutionTicks() - start;
+
+      for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < blockSize; ++i) {
+          const float expected = referenceBuffer.getSample(channel, i);
+          difference = juce::jmax(
+              difference,
+              (double)std::abs(expected - fusedBuffer.getSample(channel, i)),
+              (double)std::abs(expected -
+                               perChannelBuffer.getSample(channel, i)));
+        }
+    }
+
+    const bool ok = !row.checked || difference <= maxDifference;
+    passed = passed && ok;
+    const double referenceCost = toNanoseconds(referenceTicks, numRepeats);
+    const double fusedCost = toNanoseconds(fusedTicks, numRepeats);
+    const double perChannelCost = toNanoseconds(perChannelTicks, numRepeats);
+    std::cout << juce::String(row.name).paddedRight(' ', 20)
+              << juce::String(referenceCost, 2).paddedLeft(' ', 12)
+              << juce::String(perChannelCost, 2).paddedLeft(' ', 13)
+              << juce::String(fusedCost, 2).paddedLeft(' ', 10)
+              << (juce::String(referenceCost / fusedCost, 2) + "x")
+                     .paddedLeft(' ', 10)
+              << (juce::String::formatted("%.1e", difference) +
+                  (!row.checked ? " *" : ok ? "  " : " !"))
+                     .paddedLeft(' ', 12)
+              << "\n";
+  }
+  std::cout << "* allpass path vs split + sum (informative)\n\n";
+
+  // 2. Band switching
+  std::cout << "Switching both bands every 20 blocks of 64 samples (largest "
+               "step / the sine's)\n";
+  for (const float frequency : {100.0f, 1000.0f, 5000.0f}) {
+    ThreeBandCrossover crossover;
+    crossover.prepare(sampleRate);
+    crossover.setCutoffs(lowFrequency, highFrequency);
+
+    constexpr int switchBlockSize = 64;
+    juce::AudioBuffer<float> buffer(2, switchBlockSize);
+    const double phaseStep =
+        juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    double largestStep = 0.0;
+    float previous = 0.0f;
+    int n = 0;
+
+    for (int block = 0; block < 400; ++block) {
+      for (int i = 0; i < switchBlockSize; ++i, ++n) {
+        const float x = 0.5f * (float)std::sin(phaseStep * n);
+        buffer.setSample(0, i, x);
+        buffer.setSample(1, i, x);
+      }
+
+      ThreeBandCrossover::BandSettings settings;
+      settings.lowEnable = (block / 20) % 2 == 1;
+      settings.highEnable = settings.lowEnable;
+      crossover.process(buffer.getArrayOfWritePointers(), 2, switchBlockSize,
+                        settings);
+
+      for (int i = 0; i < switchBlockSize; ++i) {
+        const float y = buffer.getSample(0, i);
+        if (block >= 20) // skip the start-up from silence
+          largestStep = juce::jmax(largestStep, (double)std::abs(y - previous));
+        previous = y;
+      }
+    }
+
+    const double sineStep = 2.0 * 0.5 * std::sin(0.5 * phaseStep);
+    const double ratio = largestStep / sineStep;
+    const bool ok = ratio <= maxStepRatio;
+    passed = passed && ok;
+    std::cout << (juce::String((int)frequency) + " Hz").paddedRight(' ', 20)
+              << (juce::String(ratio, 3) + (ok ? "  " : " !"))
+                     .paddedLeft(' ', 12)
+              << "\n";
+  }
+  std::cout << std::endl;
+
+  if (!passed)
+    juce::ConsoleApplication::fail("Crossover check failed", 1);
+}
+
+} // namespace BenchSuites
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    OversamplingSuite.cpp
+    ---------------------
+    "steverator_bench --oversampling"
+
+    Role:
+    Runs every oversampler the plugin can use (minimum-phase IIR and
+    linear-phase FIR half-band filters, 2x to 16x) with the plugin's
+    settings, and reports for each:
+
+      latency    in samples at the host rate (what the host compensates,
+                 and what the dry path is delayed by)
+      ripple     max - min gain from 20 Hz to 20 kHz, up + down
+      20 kHz     gain at 20 kHz (how early the filters roll off)
+      cpu        ns per stereo sample for up + down, no curve in between
+
+    So the cheapest filter that meets a given passband spec can be picked.
+
+    It then prints the factor and latency "Auto" oversampling picks for
+    each session rate, for a smooth (Tube) and a wideband (HardClip)
+    waveshape, in Direct and ADAA mode.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "PluginProcessor.h"
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int analysisLength = 8192;
+constexpr int settleLength = 8192;
+
+using Oversampler = juce::dsp::Oversampling<float>;
+
+std::unique_ptr<Oversampler> createOversampler(Oversampler::FilterType type,
+                                               int stages) {
+  // Same settings as Vst_saturatorAudioProcessor::updateOversampling()
+  auto oversampler = std::make_unique<Oversampler>(2, stages, type, true, true);
+  oversampler->initProcessing(blockSize);
+  return oversampler;
+}
+
+// Gain in dB of up + down for a sine on DFT bin "bin"
+double measureGain(Oversampler &oversampler, int bin) {
+  oversampler.reset();
+  juce::AudioBuffer<float> buffer(2, blockSize);
+  std::vector<double> output;
+  output.reserve((size_t)(settleLength + analysisLength));
+
+  const double phaseStep =
+      juce::MathConstants<double>::twoPi * bin / (double)analysisLength;
+  for (int start = 0; start < settleLength + analysisLength;
+       start += blockSize) {
+    for (int i = 0; i < blockSize; ++i) {
+      const float x = 0.5f * (float)std::sin(phaseStep * (start + i));
+      buffer.setSample(0, i, x);
+      buffer.setSample(1, i, x);
+    }
+    juce::dsp::AudioBlock<float> block(buffer);
+    oversampler.processSamplesUp(block);
+    oversampler.processSamplesDown(block);
+    for (int i = 0; i < blockSize; ++i)
+      output.push_back(buffer.getSample(0, i));
+  }
+
+  double re = 0.0, im = 0.0;
+  for (int n = 0; n < analysisLength; ++n) {
+    const double phase = phaseStep * (double)n;
+    re += output[(size_t)(settleLength + n)] * std::cos(phase);
+    im -= output[(size_t)(settleLength + n)] * std::sin(phase);
+  }
+  const double amplitude = 2.0 * std::sqrt(re * re + im * im) / analysisLength;
+  return juce::Decibels::gainToDecibels(amplitude / 0.5, -200.0);
+}
+
+double measureCost(Oversampler &oversampler, int numRepeats) {
+  juce::AudioBuffer<float> buffer(2, blockSize);
+  juce::Random random(0x5eed);
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r) {
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < blockSize; ++i)
+        buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    juce::dsp::AudioBlock<float> block(buffer);
+    const auto start = juce::Time::getHighResolutionTicks();
+    oversampler.processSamplesUp(block);
+    oversampler.processSamplesDown(block);
+    ticks += juce::Time::getHighResolutionTicks() - start;
+  }
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)numRepeats * blockSize);
+}
+
+// Prepares a processor with "Auto" oversampling; returns {factor, latency}
+std::pair<int, int> autoOversampling(double rate, int waveshape, int mode) {
+  Vst_saturatorAudioProcessor processor;
+  const auto set = [&processor](const char *parameterID, float value) {
+    auto *parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+  };
+  set("oversampling", 5.0f); // Auto
+  set("waveshape", (float)waveshape);
+  set("shaperMode", (float)mode);
+  processor.setRateAndBufferSizeDetails(rate, blockSize);
+  processor.prepareToPlay(rate, blockSize);
+  return {processor.getOversamplingFactor(), processor.getLatencySamples()};
+}
+
+} // namespace
+
+void runOversamplingSuite(const juce::ArgumentList &args) {
+  const int numRepeats = getIntOption(args, "--repeats", 200);
+
+  // Test tones from 20 Hz to 20 kHz, log spaced, on DFT bins
+  std::vector<int> bins;
+  const double binWidth = sampleRate / analysisLength;
+  for (double f = 20.0; f <= 20000.0; f *= 1.15)
+    bins.push_back(juce::jmax(1, (int)std::round(f / binWidth)));
+  const int bin20k = (int)std::floor(20000.0 / binWidth);
+  bins.push_back(bin20k);
+
+  std::cout << "Oversampling filters (" << sampleRate
+            << " Hz, up + down, integer latency)\n"
+            << juce::String("filter").paddedRight(' ', 16)
+            << juce::String("factor").paddedLeft(' ', 8)
+            << juce::String("latency").paddedLeft(' ', 10)
+            << juce::String("ripple dB").paddedLeft(' ', 12)
+            << juce::String("20 kHz dB").paddedLeft(' ', 12)
+            << juce::String("ns/sample").paddedLeft(' ', 12) << "\n";
+
+  const std::pair<Oversampler::FilterType, const char *> filters[] = {
+      {Oversampler::FilterType::filterHalfBandPolyphaseIIR, "IIR"},
+      {Oversampler::FilterType::filterHalfBandFIREquiripple, "Linear Phase"}};
+
+  for (const auto &[type, name] : filters) {
+    for (int stages = 1; stages <= 4; ++stages) {
+      auto oversampler = createOversampler(type, stages);
+
+      double minGain = 1000.0, maxGain = -1000.0;
+      for (int bin : bins) {
+        const double gain = measureGain(*oversampler, bin);
+        minGain = juce::jmin(minGain, gain);
+        maxGain = juce::jmax(maxGain, gain);
+      }
+
+      std::cout << juce::String(name).paddedRight(' ', 16)
+                << (juce::String(1 << stages) + "x").paddedLeft(' ', 8)
+                << juce::String(oversampler->getLatencyInSamples(), 1)
+                       .paddedLeft(' ', 10)
+                << juce::String(maxGain - minGain, 4).paddedLeft(' ', 12)
+                << juce::String(measureGain(*oversampler, bin20k), 3)
+                       .paddedLeft(' ', 12)
+                << juce::String(measureCost(*oversampler, numRepeats), 1)
+                       .paddedLeft(' ', 12)
+                << "\n";
+    }
+  }
+
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  std::cout << "\n\"Auto\" oversampling (factor, latency in samples)\n"
+            << juce::String("rate").paddedRight(' ', 10)
+            << juce::String("Tube").paddedLeft(' ', 12)
+            << juce::String("Tube ADAA").paddedLeft(' ', 12)
+            << juce::String("HardClip").paddedLeft(' ', 12)
+            << juce::String("Clip ADAA").paddedLeft(' ', 12) << "\n";
+  for (const double rate :
+       {44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0}) {
+    std::cout << juce::String(rate, 0).paddedRight(' ', 10);
+    for (const int waveshape : {0, 2})
+      for (const int mode : {0, 2}) {
+        const auto [factor, latency] = autoOversampling(rate, waveshape, mode);
+        std::cout << (juce::String(factor) + "x, " + juce::String(latency))
+                         .paddedLeft(' ', 12);
+      }
+    std::cout << "\n";
+  }
+  std::cout << std::endl;
+}
+
+} // namespace BenchSuites
@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+    PipelineSuite.cpp
+    -----------------
+    "steverator_bench --pipeline"
+
+    Role:
+    Runs processBlock() through each of the specialized routing pipelines
+    (PluginProcessor::runPipeline(): Pre/Post order x delta off / on /
+    fading x limiter off / on / fading x Mix at 100% or not) and reports
+    the cost of each, in ns per stereo sample. A fading stage is kept
+    fading by flipping its switch every block (the crossfades last ~10 ms).
+
+    The last column compares each pipeline with the most general one of the
+    same order (both stages fading, dry mixed in), which does every stage
+    a single run-time pipeline would run.
+
+    Oversampling is 1x and both bands are off, so the routing stages are a
+    visible part of the cost.
+
+    It then compares stereo noise with the same noise on both channels,
+    which processBlock() runs once (dual mono), and times silent input
+    once processBlock() has suspended, for the default waveshape and for
+    Wavelet (which settles on a DC offset). It fails if either never
+    suspends, or if the output after the wakeup differs from that of a
+    processor that only saw silence before.
+    Last, it compares blocks with constant gains with blocks in which
+    Drive, Mix, Input and Output Gain glide (BlockRamp.h), and fails if
+    the bypassed output is not the input delayed by the reported latency.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "PluginProcessor.h"
+#include <iostream>
+#include <utility>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 64;
+constexpr int waveletIndex = 57; // a DC offset at silence: 1 + Shape
+
+class PipelineHost {
+public:
+  PipelineHost() {
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    buffer.setSize(2, blockSize);
+    set("oversampling", 0.0f); // 1x
+    prepare();
+  }
+
+  // Again, after changing the oversampling
+  void prepare() { processor.prepareToPlay(sampleRate, blockSize); }
+
+  void set(const char *parameterID, float value) {
+    auto *parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+  }
+
+  enum class Input { stereo, dualMono, silence };
+
+  // Processes one block of noise (the same on both channels for dualMono);
+  // returns the time it took, in ticks
+  juce::int64 process(Input kind = Input::stereo) {
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < blockSize; ++i)
+        buffer.setSample(channel, i,
+                         kind == Input::silence ? 0.0f
+                         : kind == Input::dualMono && channel == 1
+                             ? buffer.getSample(0, i)
+                             : random.nextFloat() - 0.5f);
+
+    input.makeCopyOf(buffer, true);
+    const auto start = juce::Time::getHighResolutionTicks();
+    processor.processBlock(buffer, midi);
+    return juce::Time::getHighResolutionTicks() - start;
+  }
+
+  void reseed(juce::int64 seed) { random.setSeed(seed); }
+  const juce::AudioBuffer<float> &getInput() const { return input; }
+  const juce::AudioBuffer<float> &getOutput() const { return buffer; }
+  int getLatencySamples() const { return processor.getLatencySamples(); }
+
+  juce::int64 getNumDualMonoBlocks() const {
+    return processor.getNumDualMonoBlocks();
+  }
+  juce::int64 getNumSuspendedBlocks() const {
+    return processor.getNumSuspendedBlocks();
+  }
+
+private:
+  Vst_saturatorAudioProcessor processor;
+  juce::AudioBuffer<float> buffer, input;
+  juce::MidiBuffer midi;
+  juce::Random random{0x5eed};
+};
+
+enum class Stage { off, on, fading };
+
+struct Variant {
+  bool post;
+  Stage delta, limiter;
+  bool mixed;
+};
+
+juce::String toString(Stage stage) {
+  return stage == Stage::off ? "off" : stage == Stage::on ? "on" : "fading";
+}
+
+double measure(const Variant &variant, int numRepeats) {
+  PipelineHost host;
+  host.set("prePost", variant.post ? 1.0f : 0.0f);
+  host.set("mix", variant.mixed ? 50.0f : 100.0f);
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r) {
+    // Flip a fading stage every block
+    const bool flip = (r % 2) == 1;
+    host.set("delta", variant.delta == Stage::on ||
+                              (variant.delta == Stage::fading && flip)
+                          ? 1.0f
+                          : 0.0f);
+    host.set("limiter", variant.limiter == Stage::on ||
+                                (variant.limiter == Stage::fading && flip)
+                            ? 1.0f
+                            : 0.0f);
+    const auto blockTicks = host.process();
+    if (r > 0) // the first block snaps the crossfades
+      ticks += blockTicks;
+  }
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)(numRepeats - 1) * blockSize);
+}
+
+// Default routing (4x oversampling, both bands on) on stereo or dual mono
+// noise; returns ns per stereo sample and the blocks that took the dual
+// mono path
+std::pair<double, juce::int64> measureDualMono(bool dualMono,
+                                               int numRepeats) {
+  PipelineHost host;
+  host.set("oversampling", 2.0f); // 4x
+  host.set("lowEnable", 1.0f);
+  host.set("highEnable", 1.0f);
+  host.set("limiter", 1.0f);
+  host.prepare();
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r)
+    ticks += host.process(dualMono ? PipelineHost::Input::dualMono
+                                   : PipelineHost::Input::stereo);
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return {seconds * 1.0e9 / ((double)numRepeats * blockSize),
+          host.getNumDualMonoBlocks()};
+}
+
+// Mix at 50%: returns ns per stereo sample with every gain constant, or
+// with Drive, Mix, Input and Output Gain moved every block (their ramps
+// never settle)
+double measureGainRamps(bool moving, int numRepeats) {
+  PipelineHost host;
+  host.set("mix", 50.0f);
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r) {
+    if (moving) {
+      const bool flip = (r % 2) == 1;
+      host.set("drive", flip ? 12.0f : 6.0f);
+      host.set("mix", flip ? 60.0f : 40.0f);
+      host.set("inputGain", flip ? 3.0f : -3.0f);
+      host.set("output", flip ? -3.0f : 3.0f);
+    }
+    const auto blockTicks = host.process();
+    if (r > 0) // the first block snaps the ramps
+      ticks += blockTicks;
+  }
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)(numRepeats - 1) * blockSize);
+}
+
+// Default routing with the limiter, for one waveshape: noise, silence until
+// processBlock() suspends, then noise again. Returns ns per stereo sample
+// of the silent blocks once suspended; fails if it never suspends, if the
+// held output is not the last one processed, or if the blocks after the
+// wakeup differ from those of a processor that only saw silence before.
+double checkSilence(int waveshape, int numRepeats) {
+  const auto setUp = [waveshape](PipelineHost &host) {
+    host.set("oversampling", 2.0f); // 4x
+    host.set("waveshape", (float)waveshape);
+    host.set("lowEnable", 1.0f);
+    host.set("highEnable", 1.0f);
+    host.set("limiter", 1.0f);
+    host.prepare();
+  };
+  PipelineHost host, settled;
+  setUp(host);
+  setUp(settled);
+  const juce::String name = "waveshape " + juce::String(waveshape);
+
+  for (int r = 0; r < 100; ++r)
+    host.process();
+  const int maxSilentBlocks = (int)(2.0 * sampleRate / blockSize);
+  float lastOutput = 0.0f;
+  for (int r = 0; r < maxSilentBlocks && host.getNumSuspendedBlocks() == 0;
+       ++r) {
+    host.process(PipelineHost::Input::silence);
+    lastOutput = host.getOutput().getSample(0, blockSize - 1);
+  }
+  for (int r = 0; r < maxSilentBlocks; ++r)
+    settled.process(PipelineHost::Input::silence);
+  if (host.getNumSuspendedBlocks() == 0)
+    juce::ConsoleApplication::fail("processBlock() never suspended on "
+                                   "silence (" + name + ")");
+
+  juce::int64 ticks = 0;
+  for (int r = 0; r < numRepeats; ++r)
+    ticks += host.process(PipelineHost::Input::silence);
+  if (std::abs(host.getOutput().getSample(0, 0) - lastOutput) > 1.0e-6f)
+    juce::ConsoleApplication::fail("The suspended output steps from " +
+                                   juce::String(lastOutput) + " to " +
+                                   juce::String(host.getOutput().getSample(
+                                       0, 0)) +
+                                   " (" + name + ")");
+
+  host.reseed(0x5eed);
+  settled.reseed(0x5eed);
+  float maxDifference = 0.0f;
+  for (int r = 0; r < 100; ++r) {
+    host.process();
+    settled.process();
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < blockSize; ++i)
+        maxDifference = juce::jmax(
+            maxDifference, std::abs(host.getOutput().getSample(channel, i) -
+                                    settled.getOutput().getSample(channel, i)));
+  }
+  // The states were kept, with what is left of the tails (below -120 dB)
+  if (maxDifference > 1.0e-5f)
+    juce::ConsoleApplication::fail(
+        "Output after waking up differs from a processor that only saw "
+        "silence by " +
+        juce::String(maxDifference) + " (" + name + ")");
+
+  const double seconds =
+      (double)ticks / (double)juce::Time::getHighResolutionTicksPerSecond();
+  return seconds * 1.0e9 / ((double)numRepeats * blockSize);
+}
+
+// 4x oversampling, bypassed: fails unless the output is the input delayed
+// by the reported latency (the host's delay compensation must hold)
+void checkBypass() {
+  PipelineHost host;
+  host.set("oversampling", 2.0f); // 4x
+  host.set("bypass", 1.0f);
+  host.prepare();
+  const int latency = host.getLatencySamples();
+  if (latency <= 0)
+    juce::ConsoleApplication::fail("No latency reported at 4x");
+
+  constexpr int numBlocks = 20;
+  juce::AudioBuffer<float> inputs(2, numBlocks * blockSize),
+      outputs(2, numBlocks * blockSize);
+  for (int r = 0; r < numBlocks; ++r) {
+    host.process();
+    for (int channel = 0; channel < 2; ++channel) {
+      inputs.copyFrom(channel, r * blockSize, host.getInput(), channel, 0,
+                      blockSize);
+      outputs.copyFrom(channel, r * blockSize, host.getOutput(), channel, 0,
+                       blockSize);
+    }
+  }
+
+  float maxDifference = 0.0f;
+  for (int channel = 0; channel < 2; ++channel)
+    for (int i = 0; i < outputs.getNumSamples(); ++i) {
+      const float expected =
+          i >= latency ? inputs.getSample(channel, i - latency) : 0.0f;
+      maxDifference = juce::jmax(
+          maxDifference, std::abs(outputs.getSample(channel, i) - expected));
+    }
+  if (maxDifference > 0.0f)
+    juce::ConsoleApplication::fail(
+        "Bypassed output differs from the input delayed by " +
+        juce::String(latency) + " samples by " + juce::String(maxDifference));
+}
+
+} // namespace
+
+void runPipelineSuite(const juce::ArgumentList &args) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  const int numRepeats = juce::jmax(2, getIntOption(args, "--repeats", 4000));
+
+  std::cout << "Routing pipelines (" << sampleRate << " Hz, blocks of "
+            << blockSize << ", 1x oversampling, ns per stereo sample)\n"
+            << juce::String("order").paddedRight(' ', 8)
+            << juce::String("delta").paddedRight(' ', 9)
+            << juce::String("limiter").paddedRight(' ', 9)
+            << juce::String("mix").paddedRight(' ', 7)
+            << juce::String("cost").paddedLeft(' ', 10)
+            << juce::String("vs general").paddedLeft(' ', 12) << "\n";
+
+  for (const bool post : {false, true}) {
+    const double general =
+        measure({post, Stage::fading, Stage::fading, true}, numRepeats);
+
+    for (const auto delta : {Stage::off, Stage::on, Stage::fading})
+      for (const auto limiter : {Stage::off, Stage::on, Stage::fading})
+        for (const bool mixed : {false, true}) {
+          const double cost =
+              measure({post, delta, limiter, mixed}, numRepeats);
+          std::cout << juce::String(post ? "Post" : "Pre").paddedRight(' ', 8)
+                    << toString(delta).paddedRight(' ', 9)
+                    << toString(limiter).paddedRight(' ', 9)
+                    << juce::String(mixed ? "50%" : "100%").paddedRight(' ', 7)
+                    << juce::String(cost, 2).paddedLeft(' ', 10)
+                    << (juce::String(general / cost, 2) + "x")
+                           .paddedLeft(' ', 12)
+                    << "\n";
+        }
+  }
+
+  // Dual mono: identical channels run the crossover, shaper and mix once
+  const auto stereo = measureDualMono(false, numRepeats);
+  const auto dualMono = measureDualMono(true, numRepeats);
+  std::cout << "\nDual mono (4x oversampling, both bands, limiter)\n"
+            << "stereo input     " << juce::String(stereo.first, 2)
+            << " ns, " << stereo.second << " dual mono blocks\n"
+            << "identical input  " << juce::String(dualMono.first, 2)
+            << " ns, " << dualMono.second << " dual mono blocks ("
+            << juce::String(stereo.first / dualMono.first, 2) << "x)\n";
+
+  // Suspend mode: the settled output is held once the tails have decayed
+  // (Wavelet settles on a DC offset)
+  std::cout << "silent input     "
+            << juce::String(checkSilence(0, numRepeats), 2)
+            << " ns once suspended\n"
+            << "silent (Wavelet) "
+            << juce::String(checkSilence(waveletIndex, numRepeats), 2)
+            << " ns once suspended\n";
+
+  // Block-rate gain ramps
+  const double constantGains = measureGainRamps(false, numRepeats);
+  const double movingGains = measureGainRamps(true, numRepeats);
+  std::cout << "\nGain ramps (1x oversampling, Mix 50%)\n"
+            << "constant gains   " << juce::String(constantGains, 2)
+            << " ns\n"
+            << "moving gains     " << juce::String(movingGains, 2) << " ns ("
+            << juce::String(movingGains / constantGains, 2) << "x)\n";
+
+  checkBypass();
+  std::cout << "\nBypass: the input delayed by the reported latency\n";
+  std::cout << std::endl;
+}
+
+} // namespace BenchSuites
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    ProcessSuite.cpp
+    ----------------
+    "steverator_bench --process"
+
+    Role:
+    Times the whole processBlock() the way a host calls it, for comparing
+    builds and sizing render machines. Each configuration gets a fresh
+    processor, prepared with prepareToPlay() at its rate and block size;
+    after a short warm-up, every block of ~1 s of stereo noise is timed on
+    its own. Three sweeps, each from the default settings:
+
+      waveshape  every waveshape (512 samples, 48 kHz)
+      block      block sizes 32 - 4096 x rates 44.1 - 192 kHz
+      routing    Pre/Post x Low band x High band x Limiter x Delta
+
+    --full runs the whole cross product instead (58 x 8 x 6 x 32
+    configurations, which takes hours).
+
+    Each configuration is one row: ns per stereo sample, the realtime
+    factor (audio time / processing time) and the 99th percentile of the
+    block time, next to the block's deadline (block size / rate). Rows are
+    printed as CSV, or as a JSON array with --format=json.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "PluginProcessor.h"
+#include "Waveshapers.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr int blockSizes[] = {32, 64, 128, 256, 512, 1024, 2048, 4096};
+constexpr double sampleRates[] = {44100.0, 48000.0,  88200.0,
+                                  96000.0, 176400.0, 192000.0};
+constexpr int numRoutings = 32; // one bit per switch
+
+struct Config {
+  const char *sweep = "";
+  int waveshape = 0;
+  int blockSize = 512;
+  double sampleRate = 48000.0;
+  int routing = 0; // bits: prePost, lowEnable, highEnable, limiter, delta
+};
+
+const char *const routingIDs[] = {"prePost", "lowEnable", "highEnable",
+                                  "limiter", "delta"};
+
+struct Result {
+  juce::String waveshapeName;
+  int oversamplingFactor = 1;
+  double nsPerSample = 0.0;
+  double realtimeFactor = 0.0;
+  double p99BlockMicroseconds = 0.0;
+};
+
+Result measure(const Config &config, double seconds) {
+  Vst_saturatorAudioProcessor processor;
+  processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+  const auto set = [&processor](const char *parameterID, float value) {
+    auto *parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+  };
+  set("waveshape", (float)config.waveshape);
+  for (int bit = 0; bit < 5; ++bit)
+    set(routingIDs[bit], (config.routing >> bit) & 1 ? 1.0f : 0.0f);
+  processor.prepareToPlay(config.sampleRate, config.blockSize);
+
+  Result result;
+  result.waveshapeName =
+      processor.apvts.getParameter("waveshape")->getCurrentValueAsText();
+  result.oversamplingFactor = processor.getOversamplingFactor();
+
+  // The same noise every run, generated outside the timed blocks
+  const int numBlocks = juce::jmax(
+      100, (int)(seconds * config.sampleRate / config.blockSize));
+  const int numWarmupBlocks = juce::jmax(4, numBlocks / 10);
+  juce::AudioBuffer<float> noise(2, config.blockSize * 8);
+  juce::Random random{0x5eed};
+  for (int channel = 0; channel < 2; ++channel)
+    for (int i = 0; i < noise.getNumSamples(); ++i)
+      noise.setSample(channel, i, random.nextFloat() - 0.5f);
+
+  juce::AudioBuffer<float> buffer(2, config.blockSize);
+  juce::MidiBuffer midi;
+  std::vector<juce::int64> ticks((size_t)numBlocks);
+  for (int b = -numWarmupBlocks; b < numBlocks; ++b) {
+    const int offset = ((b + numWarmupBlocks) % 8) * config.blockSize;
+    for (int channel = 0; channel < 2; ++channel)
+      buffer.copyFrom(channel, 0, noise, channel, offset, config.blockSize);
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    processor.processBlock(buffer, midi);
+    if (b >= 0)
+      ticks[(size_t)b] = juce::Time::getHighResolutionTicks() - start;
+  }
+
+  juce::int64 total = 0;
+  for (const auto t : ticks)
+    total += t;
+  std::sort(ticks.begin(), ticks.end());
+  const auto p99 = ticks[(size_t)((numBlocks * 99 + 99) / 100 - 1)];
+
+  const double ticksPerSecond =
+      (double)juce::Time::getHighResolutionTicksPerSecond();
+  const double processSeconds = (double)total / ticksPerSecond;
+  const double audioSeconds =
+      (double)numBlocks * config.blockSize / config.sampleRate;
+  result.nsPerSample =
+      processSeconds * 1.0e9 / ((double)numBlocks * config.blockSize);
+  result.realtimeFactor = audioSeconds / processSeconds;
+  result.p99BlockMicroseconds = (double)p99 * 1.0e6 / ticksPerSecond;
+  return result;
+}
+
+std::vector<Config> makeConfigs(bool full) {
+  std::vector<Config> configs;
+  if (full) {
+    for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape)
+      for (const int blockSize : blockSizes)
+        for (const double sampleRate : sampleRates)
+          for (int routing = 0; routing < numRoutings; ++routing)
+            configs.push_back({"full", shape, blockSize, sampleRate, routing});
+    return configs;
+  }
+
+  for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+    Config config;
+    config.sweep = "waveshape";
+    config.waveshape = shape;
+    configs.push_back(config);
+  }
+  for (const int blockSize : blockSizes)
+    for (const double sampleRate : sampleRates) {
+      Config config;
+      config.sweep = "block";
+      config.blockSize = blockSize;
+      config.sampleRate = sampleRate;
+      configs.push_back(config);
+    }
+  for (int routing = 0; routing < numRoutings; ++routing) {
+    Config config;
+    config.sweep = "routing";
+    config.routing = routing;
+    configs.push_back(config);
+  }
+  return configs;
+}
+
+} // namespace
+
+void runProcessSuite(const juce::ArgumentList &args) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  const auto secondsOption = args.getValueForOption("--seconds");
+  const double seconds =
+      secondsOption.isEmpty() ? 1.0 : secondsOption.getDoubleValue();
+  const bool json = args.getValueForOption("--format") == "json";
+  const auto configs = makeConfigs(args.containsOption("--full"));
+
+  juce::Array<juce::var> rows;
+  if (!json)
+    std::cout << "sweep,waveshape,block_size,sample_rate,oversampling,"
+                 "pre_post,low_band,high_band,limiter,delta,ns_per_sample,"
+                 "realtime_factor,p99_block_us,deadline_us\n";
+
+  for (const auto &config : configs) {
+    const auto result = measure(config, seconds);
+    const double deadlineMicroseconds =
+        config.blockSize * 1.0e6 / config.sampleRate;
+    const auto bit = [&config](int b) { return (config.routing >> b) & 1; };
+
+    if (json) {
+      auto *row = new juce::DynamicObject();
+      row->setProperty("sweep", config.sweep);
+      row->setProperty("waveshape", result.waveshapeName);
+      row->setProperty("block_size", config.blockSize);
+      row->setProperty("sample_rate", config.sampleRate);
+      row->setProperty("oversampling", result.oversamplingFactor);
+      for (int b = 0; b < 5; ++b)
+        row->setProperty(routingIDs[b], (bool)bit(b));
+      row->setProperty("ns_per_sample", result.nsPerSample);
+      row->setProperty("realtime_factor", result.realtimeFactor);
+      row->setProperty("p99_block_us", result.p99BlockMicroseconds);
+      row->setProperty("deadline_us", deadlineMicroseconds);
+      rows.add(juce::var(row));
+    } else {
+      std::cout << config.sweep << ",\"" << result.waveshapeName << "\","
+                << config.blockSize << "," << config.sampleRate << ","
+                << result.oversamplingFactor << "," << bit(0) << ","
+                << bit(1) << "," << bit(2) << "," << bit(3) << "," << bit(4)
+                << "," << juce::String(result.nsPerSample, 3) << ","
+                << juce::String(result.realtimeFactor, 2) << ","
+                << juce::String(result.p99BlockMicroseconds, 2) << ","
+                << juce::String(deadlineMicroseconds, 2) << std::endl;
+    }
+  }
+
+  if (json)
+    std::cout << juce::JSON::toString(juce::var(rows)) << std::endl;
+}
+
+} // namespace BenchSuites
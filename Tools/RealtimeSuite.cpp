@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+    RealtimeSuite.cpp
+    -----------------
+    "steverator_bench --realtime"
+
+    Role:
+    Checks that processBlock() never allocates or frees memory. The
+    allocator is hooked for the whole tool:
+
+      - operator new / delete (every platform)
+      - malloc, calloc, realloc and free (glibc: the tool's definitions
+        take precedence and forward to __libc_*; macOS: the default malloc
+        zone is patched)
+
+    Only calls made from the thread running processBlock(), while it runs,
+    are counted. The plugin is then driven through every waveshape, shaper
+    mode and quality tier, with blocks of 1, 64 and 2048 samples (more than
+    the prepared 512, so the chunking path runs too) and with the routing
+    switches off and on; and through every oversampling filter and factor,
+    both prepared by prepareToPlay() and switched while playing (the
+    message loop runs between blocks, outside the hooks, so the new
+    oversampler gets prepared). Any allocation fails the check.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "PluginProcessor.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#if JUCE_MAC
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#endif
+
+namespace {
+
+std::atomic<int> numAllocations{0};
+thread_local bool isWatching = false; // static TLS, never allocates
+
+inline void noteAllocation() {
+  if (isWatching)
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+//==============================================================================
+// operator new / delete
+
+void *operator new(std::size_t size) {
+  noteAllocation();
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  noteAllocation();
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept {
+  if (p != nullptr)
+    noteAllocation();
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept { operator delete(p); }
+void operator delete(void *p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void *p, std::size_t) noexcept { operator delete(p); }
+
+//==============================================================================
+// malloc / free
+
+#if JUCE_LINUX && defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(std::size_t);
+void *__libc_calloc(std::size_t, std::size_t);
+void *__libc_realloc(void *, std::size_t);
+void __libc_free(void *);
+
+void *malloc(std::size_t size) noexcept {
+  noteAllocation();
+  return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept {
+  noteAllocation();
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, std::size_t size) noexcept {
+  noteAllocation();
+  return __libc_realloc(p, size);
+}
+
+void free(void *p) noexcept {
+  if (p != nullptr)
+    noteAllocation();
+  __libc_free(p);
+}
+}
+#endif
+
+#if JUCE_MAC
+namespace {
+
+malloc_zone_t *hookedZone = nullptr;
+void *(*zoneMalloc)(malloc_zone_t *, size_t) = nullptr;
+void *(*zoneCalloc)(malloc_zone_t *, size_t, size_t) = nullptr;
+void *(*zoneRealloc)(malloc_zone_t *, void *, size_t) = nullptr;
+void (*zoneFree)(malloc_zone_t *, void *) = nullptr;
+
+// Patches the function pointers of the default zone (the one malloc uses)
+void hookDefaultZone() {
+  if (hookedZone != nullptr)
+    return;
+
+  vm_address_t *zones = nullptr;
+  unsigned int numZones = 0;
+  if (malloc_get_all_zones(mach_task_self(), nullptr, &zones, &numZones) !=
+          KERN_SUCCESS ||
+      numZones == 0)
+    return;
+
+  hookedZone = reinterpret_cast<malloc_zone_t *>(zones[0]);
+  vm_protect(mach_task_self(), (vm_address_t)hookedZone,
+             sizeof(malloc_zone_t), 0, VM_PROT_READ | VM_PROT_WRITE);
+
+  zoneMalloc = hookedZone->malloc;
+  zoneCalloc = hookedZone->calloc;
+  zoneRealloc = hookedZone->realloc;
+  zoneFree = hookedZone->free;
+
+  hookedZone->malloc = [](malloc_zone_t *zone, size_t size) {
+    noteAllocation();
+    return zoneMalloc(zone, size);
+  };
+  hookedZone->calloc = [](malloc_zone_t *zone, size_t count, size_t size) {
+    noteAllocation();
+    return zoneCalloc(zone, count, size);
+  };
+  hookedZone->realloc = [](malloc_zone_t *zone, void *p, size_t size) {
+    noteAllocation();
+    return zoneRealloc(zone, p, size);
+  };
+  hookedZone->free = [](malloc_zone_t *zone, void *p) {
+    if (p != nullptr)
+      noteAllocation();
+    zoneFree(zone, p);
+  };
+
+  vm_protect(mach_task_self(), (vm_address_t)hookedZone,
+             sizeof(malloc_zone_t), 0, VM_PROT_READ);
+}
+
+} // namespace
+#endif
+
+namespace BenchSuites {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int preparedBlockSize = 512;
+constexpr int maxBlockSize = 2048;
+constexpr int blockSizes[] = {1, 64, maxBlockSize};
+
+// One plugin instance, driven like a host would
+class Host {
+public:
+  Host() {
+    processor.setRateAndBufferSizeDetails(sampleRate, preparedBlockSize);
+    processor.setAnalyzerEnabled(true);
+    buffer.setSize(2, maxBlockSize);
+  }
+
+  void set(const char *parameterID, float value) {
+    auto *parameter = processor.apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+  }
+
+  void prepare() { processor.prepareToPlay(sampleRate, preparedBlockSize); }
+
+  // What a host's message thread does between blocks (the processor
+  // prepares a new oversampler from a timer)
+  void pumpMessages() {
+    juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+  }
+
+  int getOversamplingFactor() const {
+    return processor.getOversamplingFactor();
+  }
+
+  // Processes one block of noise; returns the number of allocations
+  int process(int numSamples) {
+    for (int channel = 0; channel < 2; ++channel)
+      for (int i = 0; i < numSamples; ++i)
+        buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, 0,
+                                   numSamples);
+
+    numAllocations = 0;
+    isWatching = true;
+    processor.processBlock(block, midi);
+    isWatching = false;
+    return numAllocations.load();
+  }
+
+private:
+  Vst_saturatorAudioProcessor processor;
+  juce::AudioBuffer<float> buffer;
+  juce::MidiBuffer midi;
+  juce::Random random{0x5eed};
+};
+
+void setRouting(Host &host, bool on) {
+  host.set("prePost", on ? 1.0f : 0.0f);
+  host.set("lowEnable", on ? 1.0f : 0.0f);
+  host.set("highEnable", on ? 1.0f : 0.0f);
+  host.set("delta", on ? 1.0f : 0.0f);
+  host.set("limiter", on ? 1.0f : 0.0f);
+  host.set("automationResolution", on ? 2.0f : 0.0f); // 32 samples
+  host.set("governor", on ? 1.0f : 0.0f);
+  host.set("cpuBudget", on ? 5.0f : 50.0f); // steps down when it can
+}
+
+// Runs every block size a few times; the first table-mode blocks after a
+// change fall back to the direct kernel, so tables get time to build
+int processAllBlockSizes(Host &host, bool waitForTables) {
+  int allocations = 0;
+  for (int round = 0; round < (waitForTables ? 4 : 1); ++round) {
+    for (int numSamples : blockSizes)
+      allocations += host.process(numSamples);
+    if (waitForTables)
+      juce::Thread::sleep(2);
+  }
+  return allocations;
+}
+
+} // namespace
+
+void runRealtimeSuite(const juce::ArgumentList &) {
+#if JUCE_MAC
+  hookDefaultZone();
+#endif
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  const char *const modeNames[] = {"Direct", "Table", "ADAA"};
+  bool passed = true;
+
+  std::cout << "Allocations in processBlock() (" << sampleRate
+            << " Hz, prepared for " << preparedBlockSize
+            << " samples, blocks of 1, 64 and 2048)\n";
+
+  // 1. Every waveshape, mode, quality tier and routing, default oversampling
+  {
+    Host host;
+    host.prepare();
+    std::cout << juce::String("mode").paddedRight(' ', 10)
+              << juce::String("routing").paddedRight(' ', 10)
+              << juce::String("allocations").paddedLeft(' ', 12) << "\n";
+
+    for (int mode = 0; mode < 3; ++mode) {
+      host.set("shaperMode", (float)mode);
+      for (bool routing : {false, true}) {
+        setRouting(host, routing);
+        int allocations = 0;
+        for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+          host.set("waveshape", (float)shape);
+          for (int quality = 0; quality < FastMath::numTiers; ++quality) {
+            host.set("quality", (float)quality);
+            allocations += processAllBlockSizes(host, mode != 0 && quality == 0);
+          }
+        }
+        passed = passed && allocations == 0;
+        std::cout << juce::String(modeNames[mode]).paddedRight(' ', 10)
+                  << juce::String(routing ? "all on" : "all off")
+                         .paddedRight(' ', 10)
+                  << juce::String(allocations).paddedLeft(' ', 12)
+                  << (allocations == 0 ? "" : "  !") << "\n";
+      }
+    }
+  }
+
+  // 2. Every oversampling filter and factor (a closed-form ADAA shape and a
+  // tabulated one), prepared like a host would after a latency change
+  {
+    Host host;
+    std::cout << "\n"
+              << juce::String("filter").paddedRight(' ', 14)
+              << juce::String("factor").paddedLeft(' ', 8)
+              << juce::String("allocations").paddedLeft(' ', 14) << "\n";
+
+    for (int filter = 0; filter < 2; ++filter) {
+      host.set("oversamplingFilter", (float)filter);
+      for (int factor = 0; factor < 5; ++factor) {
+        host.set("oversampling", (float)factor);
+        host.prepare();
+
+        int allocations = 0;
+        for (int mode = 0; mode < 3; ++mode) {
+          host.set("shaperMode", (float)mode);
+          for (int shape : {0, 20}) {
+            host.set("waveshape", (float)shape);
+            allocations += processAllBlockSizes(host, mode != 0);
+          }
+        }
+        passed = passed && allocations == 0;
+        std::cout << juce::String(filter == 0 ? "IIR" : "Linear Phase")
+                         .paddedRight(' ', 14)
+                  << (juce::String(1 << factor) + "x").paddedLeft(' ', 8)
+                  << juce::String(allocations).paddedLeft(' ', 14)
+                  << (allocations == 0 ? "" : "  !") << "\n";
+      }
+    }
+  }
+
+  // 3. The same, switched between blocks while playing: the wet dip, the
+  // switch in processChunk() and the table preparation it does
+  {
+    Host host;
+    host.prepare();
+    std::cout << "\n"
+              << juce::String("switch to").paddedRight(' ', 22)
+              << juce::String("allocations").paddedLeft(' ', 14) << "\n";
+
+    // ~100 ms of blocks of 64: the timer, the dip, the settling and the
+    // fade back all happen within it
+    constexpr int blocksPerSwitch = 75;
+    for (int filter = 0; filter < 2; ++filter) {
+      for (int factor = 0; factor < 5; ++factor) {
+        host.set("oversamplingFilter", (float)filter);
+        host.set("oversampling", (float)factor);
+
+        int allocations = 0;
+        for (int mode = 0; mode < 3; ++mode) {
+          host.set("shaperMode", (float)mode);
+          host.set("waveshape", mode == 2 ? 20.0f : 0.0f); // tabulated ADAA
+          for (int block = 0; block < blocksPerSwitch; ++block) {
+            allocations += host.process(64);
+            host.pumpMessages();
+          }
+        }
+        const bool switched = host.getOversamplingFactor() == (1 << factor);
+        passed = passed && allocations == 0 && switched;
+        std::cout << (juce::String(filter == 0 ? "IIR " : "Linear Phase ") +
+                      juce::String(1 << factor) + "x")
+                         .paddedRight(' ', 22)
+                  << juce::String(allocations).paddedLeft(' ', 14)
+                  << (allocations == 0 ? "" : "  !")
+                  << (switched ? "" : "  (never switched)") << "\n";
+      }
+    }
+  }
+  std::cout << std::endl;
+
+  if (!passed)
+    juce::ConsoleApplication::fail("processBlock() allocated memory", 1);
+}
+
+} // namespace BenchSuites
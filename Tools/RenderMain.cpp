@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+    --------------
+    Entry point of the steverator_render command line tool.
+
+    Role:
+    Renders audio files through Vst_saturatorAudioProcessor (the plugin's
+    DSP, without its editor), for batch processing stems without bouncing
+    them through a DAW:
+
+      steverator_render [--state=file] [--preset=name] [--block=N]
+                        [--jobs=N] [--output=dir] [--suffix=text] [--tail]
+                        file...
+      steverator_render --presets
+      steverator_render --save-state=file [--state=file] [--preset=name]
+
+    --state loads a saved plugin state: the XML of the parameters
+    (<Parameters>...</Parameters>, as written by --save-state) or the
+    binary state a host stores in its session. --preset then applies a
+    factory preset by name (on top of --state, if both are given).
+
+    Each WAV or AIFF file (mono or stereo) is rendered into --output
+    (default: next to the input) as <name><suffix>.<ext> (default suffix
+    "_steverator"), with the input's rate, channel count and bit depth.
+    Files are streamed block by block (--block samples, default 512), so
+    their length does not matter. The plugin latency is compensated, so
+    the output lines up with the input and has the same length; --tail
+    also renders the plugin's tail after the end of the input.
+
+    Files are rendered in parallel: --jobs worker threads (default: one per
+    core), each with its own processor, take the next file in turn.
+    Processors run in non-realtime mode, as in a DAW bounce ("Offline"
+    oversampling, no CPU governor).
+
+    Options take the "--name=value" form. The tool exits with a non-zero
+    code if a file could not be rendered.
+
+  ==============================================================================
+*/
+
+#include "FactoryPresets.h"
+#include "PluginProcessor.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct RenderSettings {
+  juce::MemoryBlock state; // getStateInformation() format
+  int blockSize = 512;
+  juce::File outputDirectory; // empty: next to each input
+  juce::String suffix = "_steverator";
+  bool renderTail = false;
+};
+
+// Guards std::cout between workers
+juce::CriticalSection printLock;
+
+void print(const juce::String &line) {
+  const juce::ScopedLock lock(printLock);
+  std::cout << line << std::endl;
+}
+
+//==============================================================================
+// Renders files until none are left; one processor per worker
+class RenderWorker : public juce::Thread {
+public:
+  RenderWorker(const RenderSettings &settingsToUse,
+               const juce::Array<juce::File> &filesToRender,
+               std::atomic<int> &nextFileIndex,
+               std::vector<juce::String> &errorsOut)
+      : juce::Thread("steverator_render worker"), settings(settingsToUse),
+        files(filesToRender), nextFile(nextFileIndex), errors(errorsOut) {
+    // Created on the message thread, like a plugin instance
+    processor.setStateInformation(settings.state.getData(),
+                                  (int)settings.state.getSize());
+    processor.setNonRealtime(true);
+    formatManager.registerBasicFormats();
+  }
+
+  void run() override {
+    while (!threadShouldExit()) {
+      const int index = nextFile++;
+      if (index >= files.size())
+        return;
+      errors[(size_t)index] = render(files.getReference(index));
+    }
+  }
+
+private:
+  const RenderSettings &settings;
+  const juce::Array<juce::File> &files;
+  std::atomic<int> &nextFile;
+  std::vector<juce::String> &errors;
+
+  Vst_saturatorAudioProcessor processor;
+  juce::AudioFormatManager formatManager;
+
+  // Returns an error message, or an empty string
+  juce::String render(const juce::File &input) {
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager.createReaderFor(input));
+    if (reader == nullptr)
+      return "not a readable WAV or AIFF file";
+    const int numChannels = (int)reader->numChannels;
+    if (numChannels < 1 || numChannels > 2)
+      return "only mono and stereo files are supported";
+    const double sampleRate = reader->sampleRate;
+
+    const auto directory = settings.outputDirectory == juce::File()
+                               ? input.getParentDirectory()
+                               : settings.outputDirectory;
+    const auto output = directory.getChildFile(
+        input.getFileNameWithoutExtension() + settings.suffix +
+        input.getFileExtension());
+    if (output == input)
+      return "the output would overwrite the input (use --suffix)";
+
+    // Same format, rate, channels and bit depth as the input
+    auto *format = formatManager.findFormatForFileExtension(
+        input.getFileExtension());
+    if (format == nullptr)
+      return "unknown file extension";
+    int bitDepth = (int)reader->bitsPerSample;
+    if (!format->getPossibleBitDepths().contains(bitDepth))
+      bitDepth = 24;
+    output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(output.createOutputStream());
+    if (stream == nullptr)
+      return "cannot write " + output.getFullPathName();
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+        stream.get(), sampleRate, (unsigned int)numChannels, bitDepth,
+        reader->metadataValues, 0));
+    if (writer == nullptr)
+      return "cannot write this format at " + juce::String(bitDepth) +
+             " bits";
+    stream.release(); // owned by the writer
+
+    // The processor is always stereo; mono files are read into both
+    // channels (which it processes once, as dual mono) and written from
+    // the first one
+    const int blockSize = settings.blockSize;
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    const juce::int64 latency = processor.getLatencySamples();
+    const juce::int64 tailSamples =
+        settings.renderTail
+            ? (juce::int64)std::ceil(processor.getTailLengthSeconds() *
+                                     sampleRate)
+            : 0;
+    const juce::int64 numOutputSamples = reader->lengthInSamples + tailSamples;
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    juce::int64 readPosition = 0, numWritten = 0;
+    juce::int64 latencyLeft = latency; // output samples to drop
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    while (numWritten < numOutputSamples) {
+      if (threadShouldExit())
+        return "cancelled";
+      // Past the end of the file, the reader fills the buffer with zeros
+      reader->read(&buffer, 0, blockSize, readPosition, true, true);
+      readPosition += blockSize;
+      processor.processBlock(buffer, midi);
+
+      const int skipped = (int)juce::jmin(latencyLeft, (juce::int64)blockSize);
+      latencyLeft -= skipped;
+      const int count = (int)juce::jmin((juce::int64)(blockSize - skipped),
+                                        numOutputSamples - numWritten);
+      if (count > 0 && !writer->writeFromAudioSampleBuffer(buffer, skipped,
+                                                            count))
+        return "write error in " + output.getFullPathName();
+      numWritten += juce::jmax(0, count);
+    }
+    processor.releaseResources();
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(
+        juce::Time::getHighResolutionTicks() - start);
+    const double audioSeconds = (double)numOutputSamples / sampleRate;
+    print(input.getFileName() + " -> " + output.getFullPathName() + "  (" +
+          juce::String(seconds, 2) + " s, " +
+          juce::String(audioSeconds / juce::jmax(seconds, 1.0e-9), 1) +
+          "x realtime)");
+    return {};
+  }
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderWorker)
+};
+
+//==============================================================================
+// Builds the state from --state and --preset (fails on a bad value)
+juce::MemoryBlock loadState(const juce::ArgumentList &args) {
+  Vst_saturatorAudioProcessor processor;
+  const auto stateType = processor.apvts.state.getType();
+
+  if (args.containsOption("--state")) {
+    const auto file = args.getFileForOption("--state");
+    juce::MemoryBlock data;
+    if (!file.loadFileAsData(data))
+      juce::ConsoleApplication::fail("Cannot read " + file.getFullPathName());
+
+    // XML as text, or the binary state a host stores
+    std::unique_ptr<juce::XmlElement> xml(juce::parseXML(data.toString()));
+    if (xml == nullptr)
+      xml = juce::AudioProcessor::getXmlFromBinary(data.getData(),
+                                                    (int)data.getSize());
+    if (xml == nullptr || !xml->hasTagName(stateType))
+      juce::ConsoleApplication::fail(file.getFullPathName() +
+                                     " is not a Steverator state");
+    processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+  }
+
+  if (args.containsOption("--preset")) {
+    const auto name = args.getValueForOption("--preset");
+    const auto presets = FactoryPresets::create();
+    const int index = FactoryPresets::findByName(presets, name);
+    if (index < 0)
+      juce::ConsoleApplication::fail("Unknown preset \"" + name +
+                                     "\" (see --presets)");
+    FactoryPresets::apply(processor.apvts, presets[(size_t)index]);
+  }
+
+  juce::MemoryBlock state;
+  processor.getStateInformation(state);
+  return state;
+}
+
+void listPresets(const juce::ArgumentList &) {
+  for (const auto &preset : FactoryPresets::create())
+    std::cout << preset.name << "\n";
+  std::cout << std::flush;
+}
+
+void saveState(const juce::ArgumentList &args) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  const auto state = loadState(args);
+  const auto file = args.getFileForOption("--save-state");
+  std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(
+      state.getData(), (int)state.getSize()));
+  if (xml == nullptr || !xml->writeTo(file))
+    juce::ConsoleApplication::fail("Cannot write " + file.getFullPathName());
+}
+
+void renderFiles(const juce::ArgumentList &args) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+  RenderSettings settings;
+  settings.state = loadState(args);
+  if (args.containsOption("--block"))
+    settings.blockSize = args.getValueForOption("--block").getIntValue();
+  if (settings.blockSize < 1)
+    juce::ConsoleApplication::fail("--block must be at least 1");
+  if (args.containsOption("--output")) {
+    settings.outputDirectory = args.getFileForOption("--output");
+    if (!settings.outputDirectory.createDirectory())
+      juce::ConsoleApplication::fail(
+          "Cannot create " + settings.outputDirectory.getFullPathName());
+  }
+  if (args.containsOption("--suffix"))
+    settings.suffix = args.getValueForOption("--suffix");
+  settings.renderTail = args.containsOption("--tail");
+
+  juce::Array<juce::File> files;
+  for (const auto &argument : args.arguments)
+    if (!argument.isOption())
+      files.add(argument.resolveAsFile());
+  if (files.isEmpty())
+    juce::ConsoleApplication::fail("No input files (see --help)");
+
+  int numJobs = juce::SystemStats::getNumCpus();
+  if (args.containsOption("--jobs"))
+    numJobs = args.getValueForOption("--jobs").getIntValue();
+  numJobs = juce::jlimit(1, files.size(), numJobs);
+
+  std::atomic<int> nextFile{0};
+  std::vector<juce::String> errors((size_t)files.size());
+  std::vector<std::unique_ptr<RenderWorker>> workers;
+  for (int i = 0; i < numJobs; ++i)
+    workers.push_back(
+        std::make_unique<RenderWorker>(settings, files, nextFile, errors));
+  for (auto &worker : workers)
+    worker->startThread();
+  for (auto &worker : workers)
+    worker->waitForThreadToExit(-1);
+
+  int numFailed = 0;
+  for (int i = 0; i < files.size(); ++i)
+    if (errors[(size_t)i].isNotEmpty()) {
+      std::cerr << files[i].getFullPathName() << ": " << errors[(size_t)i]
+                << "\n";
+      ++numFailed;
+    }
+  if (numFailed > 0)
+    juce::ConsoleApplication::fail(juce::String(numFailed) + " of " +
+                                   juce::String(files.size()) +
+                                   " files failed");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  juce::ConsoleApplication app;
+  app.addHelpCommand("--help|-h", "Usage:", false);
+
+  app.addCommand({"--presets", "--presets", "Lists the factory presets", "",
+                  listPresets});
+
+  app.addCommand({"--save-state",
+                  "--save-state=file [--state=file] [--preset=name]",
+                  "Writes the state as XML (to edit, or to use with --state)",
+                  "", saveState});
+
+  app.addDefaultCommand(
+      {"", "[--state=file] [--preset=name] [--block=N] [--jobs=N] "
+           "[--output=dir] [--suffix=text] [--tail] file...",
+       "Renders WAV/AIFF files through the plugin", "", renderFiles});
+
+  return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    ShaperSuite.cpp
+    ---------------
+    "steverator_bench --shaper"
+
+    Role:
+    1. Per-ISA throughput of every waveshape kernel, for each accuracy tier
+       (see SimdWaveshapers::createThroughputReport).
+    2. Direct vs Table mode: the spread between the cheapest and the most
+       expensive waveshape, which is what makes CPU usage jump when a preset
+       changes the waveshape.
+    3. Wideband curves: measures the criterion of Waveshapers::isWideband()
+       for every curve and fails if the list disagrees with it.
+
+  ==============================================================================
+*/
+
+#include "BenchSuites.h"
+#include "SimdWaveshapers.h"
+#include "WaveshaperTable.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace BenchSuites {
+
+namespace {
+
+struct Spread {
+  double slowest = 1.0e30, fastest = 0.0;
+  int slowestShape = 0, fastestShape = 0;
+
+  void add(int shape, double msps) {
+    if (msps < slowest) {
+      slowest = msps;
+      slowestShape = shape;
+    }
+    if (msps > fastest) {
+      fastest = msps;
+      fastestShape = shape;
+    }
+  }
+};
+
+juce::String describe(const char *name, const Spread &spread) {
+  return juce::String(name).paddedRight(' ', 8) +
+         juce::String::formatted(
+             "slowest %7.1f (shape %2d)  fastest %7.1f (shape %2d)  "
+             "ratio %5.1fx\n",
+             spread.slowest, spread.slowestShape, spread.fastest,
+             spread.fastestShape, spread.fastest / spread.slowest);
+}
+
+void printTableModeReport(int numSamples, int numRepeats) {
+  juce::Random random(0x5eed);
+  juce::HeapBlock<float> source(numSamples), work(numSamples);
+  for (int i = 0; i < numSamples; ++i)
+    source[i] = random.nextFloat() * 4.0f - 2.0f;
+
+  const double ticksPerSecond =
+      (double)juce::Time::getHighResolutionTicksPerSecond();
+  auto measure = [&](auto &&process) {
+    juce::int64 ticks = 0;
+    for (int r = 0; r < numRepeats; ++r) {
+      std::copy(source.get(), source.get() + numSamples, work.get());
+      const auto start = juce::Time::getHighResolutionTicks();
+      process(work.get());
+      ticks += juce::Time::getHighResolutionTicks() - start;
+    }
+    const double seconds = juce::jmax(1.0e-9, (double)ticks / ticksPerSecond);
+    return (double)numSamples * numRepeats / seconds / 1.0e6;
+  };
+
+  const auto isa = SimdWaveshapers::getBestIsa();
+  const auto &kernels = SimdWaveshapers::getKernelTable(isa);
+  WaveshaperTable table;
+  table.prepare(192000.0);
+
+  Spread direct, lookup;
+  for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+    if (!WaveshaperTable::supports(shape))
+      continue;
+
+    direct.add(shape, measure([&](float *data) {
+                 kernels[(size_t)shape](data, numSamples, 1.5f, 0.5f);
+               }));
+
+    // Wait for the background thread, then let the crossfade finish
+    while (!table.beginBlock(shape, 0.5f))
+      juce::Thread::sleep(1);
+    for (int i = 0; i < 50; ++i) {
+      juce::Thread::sleep(1);
+      table.beginBlock(shape, 0.5f);
+      table.endBlock(1 << 20);
+    }
+
+    lookup.add(shape, measure([&](float *data) {
+                 table.beginBlock(shape, 0.5f);
+                 table.processChannel(data, numSamples, 1.5f);
+                 table.endBlock(numSamples);
+               }));
+  }
+
+  std::cout << "Direct vs Table mode (Msamples/s, "
+            << SimdWaveshapers::getIsaName(isa) << " Exact, Crackle excluded)\n"
+            << describe("Direct", direct) << describe("Table", lookup)
+            << std::endl;
+}
+
+// Share of the output power above the widebandHarmonic-th harmonic, in dB.
+// One period of the sine spans analysisLength samples, so every harmonic
+// lands on its own DFT bin (Parseval, as in AdaaSuite.cpp).
+double measureHighHarmonics(int shape) {
+  constexpr int analysisLength = 16384;
+  const auto curve = Waveshapers::getSampleFunction(shape);
+  std::vector<double> x((size_t)analysisLength);
+  double mean = 0.0;
+  for (int n = 0; n < analysisLength; ++n) {
+    const float input = (float)std::sin(juce::MathConstants<double>::twoPi *
+                                        n / analysisLength);
+    x[(size_t)n] = curve(input * Waveshapers::widebandDrive,
+                         Waveshapers::widebandShape);
+    mean += x[(size_t)n] / analysisLength;
+  }
+
+  double total = 0.0;
+  for (auto &sample : x) {
+    sample -= mean;
+    total += sample * sample;
+  }
+
+  // Bin k (0 < k < N/2) holds 2|X_k|^2 / N of the energy
+  double low = 0.0;
+  for (int k = 1; k <= Waveshapers::widebandHarmonic; ++k) {
+    double re = 0.0, im = 0.0;
+    for (int n = 0; n < analysisLength; ++n) {
+      const double phase = juce::MathConstants<double>::twoPi *
+                           (double)((k * n) % analysisLength) /
+                           analysisLength;
+      re += x[(size_t)n] * std::cos(phase);
+      im -= x[(size_t)n] * std::sin(phase);
+    }
+    low += 2.0 * (re * re + im * im) / analysisLength;
+  }
+
+  const double high = juce::jmax(total - low, 1.0e-30);
+  return 10.0 * std::log10(high / juce::jmax(total, 1.0e-30));
+}
+
+void checkWidebandList() {
+  std::cout << "Wideband curves (power above harmonic "
+            << Waveshapers::widebandHarmonic << " at +6 dB drive, limit "
+            << Waveshapers::widebandThresholdDb << " dB)\n";
+
+  juce::StringArray mismatches;
+  for (int shape = 0; shape < Waveshapers::numWaveshapes; ++shape) {
+    if (shape == Waveshapers::crackleIndex)
+      continue; // random noise, see isWideband()
+
+    const double db = measureHighHarmonics(shape);
+    const bool measured = db > Waveshapers::widebandThresholdDb;
+    const bool listed = Waveshapers::isWideband(shape);
+    std::cout << juce::String::formatted("  shape %2d  %7.1f dB  %s%s\n",
+                                         shape, db,
+                                         listed ? "wideband" : "smooth",
+                                         measured == listed ? ""
+                                                            : "  MISMATCH");
+    if (measured != listed)
+      mismatches.add(juce::String(shape));
+  }
+  std::cout << std::endl;
+
+  if (!mismatches.isEmpty())
+    juce::ConsoleApplication::fail(
+        "Waveshapers::isWideband() disagrees with its criterion for shapes " +
+            mismatches.joinIntoString(", "),
+        1);
+}
+
+} // namespace
+
+void runShaperSuite(const juce::ArgumentList &args) {
+  const auto tierName = args.getValueForOption("--tier").toLowerCase();
+  const int numSamples = getIntOption(args, "--samples", 4096);
+  const int numRepeats = getIntOption(args, "--repeats", 200);
+
+  for (int i = 0; i < FastMath::numTiers; ++i) {
+    const auto tier = static_cast<FastMath::Tier>(i);
+    if (tierName.isNotEmpty() &&
+        tierName != juce::String(FastMath::getTierName(tier)).toLowerCase())
+      continue;
+
+    std::cout << SimdWaveshapers::createThroughputReport(tier, numSamples,
+                                                         numRepeats)
+              << std::endl;
+  }
+
+  printTableModeReport(numSamples, numRepeats);
+  checkWidebandList();
+}
+
+} // namespace BenchSuites